@@ -9,24 +9,42 @@
 // constants POINTS[1], POINTS[2]...
 
 #include <iostream>    // provides cout.
-#include <cstring>     // provides memcpy.
+#include <cstring>     // provides memcpy, memcmp.
 #include <cstdlib>     // provides size_t.
+#include <cmath>       // provides NAN.
+#include <cstdio>      // provides remove.
+#include <stdexcept>   // provides runtime_error.
+#include <unistd.h>    // provides truncate.
+#include <vector>      // provides vector.
+#include <algorithm>   // provides sort, equal, lower_bound, upper_bound.
+#include <sstream>     // provides stringstream, istringstream.
+#include <string>      // provides string.
 #include "Sequence.h"  // provides the sequence class with double items.
+#include "FileSequence.h"  // provides file_sequence.
+#include "ChunkedSequence.h"  // provides chunked_sequence.
 using namespace std;
 using namespace CS3358_Sp2016;
 
 // Descriptions and points for each of the tests:
-const size_t MANY_TESTS = 7;
+const size_t MANY_TESTS = 15;
 const int POINTS[MANY_TESTS+1] =
 {
-    21,  // Total points for all tests.
+    45,  // Total points for all tests.
      4,  // Test 1 points
      4,  // Test 2 points
      4,  // Test 3 points
      2,  // Test 4 points
      2,  // Test 5 points
      2,  // Test 6 points
-     3  // Test 7 points
+     3,  // Test 7 points
+     3,  // Test 8 points
+     3,  // Test 9 points
+     3,  // Test 10 points
+     3,  // Test 11 points
+     3,  // Test 12 points
+     3,  // Test 13 points
+     3,  // Test 14 points
+     3  // Test 15 points
 };
 const char DESCRIPTION[MANY_TESTS+1][256] =
 {
@@ -37,7 +55,15 @@ const char DESCRIPTION[MANY_TESTS+1][256] =
     "Testing the resize member function",
     "Testing the copy constructor",
     "Testing the assignment operator",
-    "Testing insert/attach when current DEFAULT_CAPACITY exceeded"
+    "Testing insert/attach when current DEFAULT_CAPACITY exceeded",
+    "Testing that copies which share an array stay independent",
+    "Testing that a file_sequence survives being closed and reopened",
+    "Testing the vector reductions and searches against plain loops",
+    "Testing sort and sorted mode, below and above the parallel threshold",
+    "Testing scans and rolling windows against plain loops",
+    "Testing load_text, save_text, load and save",
+    "Testing remove_current and block merging of chunked_sequence",
+    "Testing strided views and slices of a sequence"
 };
 
 
@@ -724,6 +750,1286 @@ int test7()
     return POINTS[7];
 }
 
+
+// **************************************************************************
+// int test8()
+//   Performs some tests of copies that share one dynamic array (until one
+//   of them is changed). Each function that changes the items is called on
+//   a copy, and the original must be left as it was.
+//   Returns POINTS[8] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test8()
+{
+    const size_t MANY = 10;
+    sequence original; // A sequence whose copies we'll change.
+    sequence full;     // A sequence at its capacity.
+    double items[MANY];
+    double sorted_items[MANY + 1];
+    double full_items[sequence::DEFAULT_CAPACITY];
+    size_t i;
+
+    // The original holds MANY...1 (out of order, so sort has work to do).
+    for (i = 0; i < MANY; i++)
+    {
+        items[i] = double(MANY - i);
+        original.attach(items[i]);
+        sorted_items[i + 1] = double(i + 1);
+    }
+    sorted_items[0] = 0.5;
+
+    cout << "Changing a copy with insert, attach and remove_current." << endl;
+    sequence copy1(original);
+    copy1.insert(99);
+    copy1.attach(98);
+    copy1.start();
+    copy1.remove_current();
+    if (!test_basic(copy1, MANY + 1, true)) return 0;
+    if (!correct(original, MANY, MANY - 1, items)) return 0;
+
+    cout << "Changing an assigned copy with sort." << endl;
+    sequence copy2;
+    copy2 = original;
+    copy2.sort();
+    copy2.start();
+    if (copy2.current() != 1)
+    {
+        cout << "sort did not sort the copy." << endl;
+        return 0;
+    }
+    original.start();
+    if (!correct(original, MANY, 0, items)) return 0;
+
+    cout << "Changing a copy with set_sorted and resize." << endl;
+    sequence copy3(original);
+    copy3.set_sorted(true);
+    copy3.insert(0.5);
+    sequence copy4(original);
+    copy4.resize(2 * MANY);
+    copy4.start();
+    copy4.remove_current();
+    original.start();
+    if (!correct(original, MANY, 0, items)) return 0;
+
+    cout << "Changing a copy of a copy, then dropping a copy." << endl;
+    sequence copy5(copy3);
+    {
+        sequence copy6(original);
+        sequence copy7(copy6);
+        copy7.start();
+        copy7.remove_current();
+    }   // copy6 and copy7 are destroyed here, but the array lives on.
+    copy5.start();
+    copy5.remove_current();
+    if (!correct(copy3, MANY + 1, 0, sorted_items)) return 0;
+    original.start();
+    if (!correct(original, MANY, 0, items)) return 0;
+
+    cout << "Changing the original, leaving its copy alone." << endl;
+    sequence copy8(original);
+    original.start();
+    original.remove_current();
+    copy8.start();
+    if (!correct(copy8, MANY, 0, items)) return 0;
+    original.start();
+    if (!correct(original, MANY - 1, 0, items + 1)) return 0;
+
+    cout << "Changing a copy of a sequence that is at its capacity." << endl;
+    for (i = 0; i < sequence::DEFAULT_CAPACITY; i++)
+    {
+        full_items[i] = double(i + 1);
+        full.attach(full_items[i]);
+    }
+    sequence copy9(full);
+    copy9.attach(0);
+    copy9.start();
+    copy9.insert(0);
+    if (!test_basic(copy9, sequence::DEFAULT_CAPACITY + 2, true)) return 0;
+    if (!correct
+        (full, sequence::DEFAULT_CAPACITY, sequence::DEFAULT_CAPACITY - 1,
+         full_items)
+        )
+        return 0;
+
+    // All tests passed
+    cout << "All tests of this eighth function have been passed." << endl;
+    return POINTS[8];
+}
+
+// **************************************************************************
+// bool file_correct(file_sequence& test, size_t s, double items[])
+//   Postcondition: A return value of true indicates that test has exactly
+//   s items, equal to items[0] ... items[s-1]. Otherwise the return value
+//   is false. In either case, a description of the result is printed.
+// NOTE: The function also moves the cursor off the sequence.
+// **************************************************************************
+bool file_correct(file_sequence& test, size_t s, double items[])
+{
+    size_t i = 0;
+
+    cout << "Checking that the file holds " << s << " items ... ";
+    test.start();
+    while (i < s && test.is_item() && test.current() == items[i])
+    {
+        test.advance();
+        i++;
+    }
+    bool answer = (i == s) && !test.is_item() && (test.size() == s);
+    cout << (answer ? "Passed." : "Failed.") << endl;
+    return answer;
+}
+
+
+// **************************************************************************
+// int test9()
+//   Performs some tests of a file_sequence that is closed and reopened:
+//   the items and the cursor must come back, after growing and shrinking,
+//   and a file left longer than its capacity (as a resize that is stopped
+//   part way leaves it) must still open. A file cut short must not.
+//   Returns POINTS[9] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test9()
+{
+    const char NAME[] = "a3test.seq";
+    const size_t HEADER = 64;   // Bytes before the items in the file
+    double items[40];
+    size_t i;
+
+    for (i = 0; i < 40; i++)
+        items[i] = i + 0.5;
+    remove(NAME);
+
+    cout << "Creating a file with capacity 4 and attaching 10 items." << endl;
+    {
+        file_sequence f(NAME, 4);
+        for (i = 0; i < 10; i++)
+            f.attach(items[i]);
+        f.start();
+        f.advance();
+        f.advance();    // The cursor is left at item [2].
+    }
+    cout << "Reopening it; the cursor should still be at item [2]." << endl;
+    {
+        file_sequence f(NAME);
+        if (!f.is_item() || f.current() != items[2])
+        {
+            cout << "The cursor was not kept." << endl;
+            return 0;
+        }
+        if (!file_correct(f, 10, items)) return 0;
+        f.resize(100);
+        f.resize(12);
+    }
+    cout << "Reopening after growing to 100 and shrinking to 12." << endl;
+    {
+        file_sequence f(NAME);
+        if (f.capacity() != 12)
+        {
+            cout << "The capacity was not kept." << endl;
+            return 0;
+        }
+        if (!file_correct(f, 10, items)) return 0;
+    }
+
+    cout << "Making the file longer than its capacity (as if a resize was\n"
+         << "stopped after growing the file) and reopening." << endl;
+    if (truncate(NAME, HEADER + 50 * sizeof(double)) != 0)
+    {
+        cout << "Could not lengthen the test file." << endl;
+        return 0;
+    }
+    {
+        file_sequence f(NAME);
+        if (!file_correct(f, 10, items)) return 0;
+        for (i = 10; i < 40; i++)
+            f.attach(items[i]);   // Grows past the old length of the file
+    }
+    {
+        file_sequence f(NAME);
+        if (!file_correct(f, 40, items)) return 0;
+    }
+
+    cout << "Cutting the file short; reopening must fail." << endl;
+    if (truncate(NAME, HEADER + 5 * sizeof(double)) != 0)
+    {
+        cout << "Could not shorten the test file." << endl;
+        return 0;
+    }
+    try
+    {
+        file_sequence f(NAME);
+        cout << "A file too short for its capacity was opened." << endl;
+        remove(NAME);
+        return 0;
+    }
+    catch (const runtime_error&)
+    {
+        cout << "It failed, as it should." << endl;
+    }
+    remove(NAME);
+
+    // All tests passed
+    cout << "All tests of this ninth function have been passed." << endl;
+    return POINTS[9];
+}
+
+// **************************************************************************
+// void fill_values(double data[], size_t n, unsigned long seed)
+//   Postcondition: data[0] ... data[n-1] hold whole numbers from -1000 to
+//   1000 made by a simple generator started from seed, so that the same
+//   seed gives the same numbers. Sums of them are exact in a double.
+// **************************************************************************
+void fill_values(double data[], size_t n, unsigned long seed)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        seed = (seed * 1103515245 + 12345) % 2147483648UL;
+        data[i] = double(long(seed >> 8) % 2001 - 1000);
+    }
+}
+
+
+// **************************************************************************
+// int test10()
+//   Performs some tests of the reductions and searches (which use AVX2
+//   where the processor has it) against plain loops, for every length
+//   from 0 to 40 (so that every leftover tail after the vector loops is
+//   tried) and some longer ones, and through the sequence's own functions.
+//   Returns POINTS[10] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test10()
+{
+    const size_t LONG_SIZES[] = { 1000, 1001, 1002, 1003, 4099 };
+    const size_t MANY_LONG = sizeof(LONG_SIZES) / sizeof(LONG_SIZES[0]);
+    vector<double> data;
+    double total;
+    double low;
+    double high;
+    size_t low_at;
+    size_t high_at;
+    size_t n;
+    size_t i;
+    size_t j;
+
+    cout << "Checking sum, min, max, argmin, argmax, find and\n"
+         << "find_first_greater for lengths 0 to 40 and some longer ones ... ";
+    cout.flush();
+    for (j = 0; j <= 40 + MANY_LONG; j++)
+    {
+        n = (j <= 40) ? j : LONG_SIZES[j - 41];
+        data.assign(n + 1, 0.0);
+        fill_values(&data[0], n, j);
+        total = 0.0;
+        low_at = high_at = 0;
+        for (i = 0; i < n; i++)
+        {
+            total += data[i];
+            if (data[i] < data[low_at]) low_at = i;
+            if (data[i] > data[high_at]) high_at = i;
+        }
+        low = data[low_at];
+        high = data[high_at];
+        if (seq_sum(&data[0], n) != total
+            || seq_sum(&data[0], n, SUM_KAHAN) != total
+            || seq_sum(&data[0], n, SUM_PAIRWISE) != total)
+        {
+            cout << "\n    The sum of " << n << " items was wrong." << endl;
+            return 0;
+        }
+        if (n > 0
+            && (seq_min(&data[0], n) != low || seq_max(&data[0], n) != high
+                || seq_argmin(&data[0], n) != low_at
+                || seq_argmax(&data[0], n) != high_at))
+        {
+            cout << "\n    The min or max of " << n << " items was wrong."
+                 << endl;
+            return 0;
+        }
+        // The last item (in the tail), the first, and one not there.
+        for (i = 0; i < n; i++)
+            if (data[i] == data[n - 1])
+                break;
+        if (n > 0
+            && (seq_find(&data[0], n, data[n - 1]) != i
+                || seq_find(&data[0], n, data[0]) != 0
+                || seq_find(&data[0], n, 5000) != n
+                || seq_find_first_greater(&data[0], n, high - 1) != high_at
+                || seq_find_first_greater(&data[0], n, high) != n))
+        {
+            cout << "\n    A search of " << n << " items was wrong." << endl;
+            return 0;
+        }
+        // A NaN is never equal to, nor greater than, anything.
+        if (n > 0)
+        {
+            data[n - 1] = NAN;
+            if (seq_find(&data[0], n, data[n - 1]) != n
+                || seq_find_first_greater(&data[0], n, high) != n)
+            {
+                cout << "\n    A search of " << n << " items went wrong"
+                     << " with a NaN." << endl;
+                return 0;
+            }
+        }
+    }
+    cout << "Passed." << endl;
+
+    cout << "Checking that the Kahan and pairwise sums of a million 0.1s\n"
+         << "are close to 100000 ... ";
+    cout.flush();
+    data.assign(1000000, 0.1);
+    total = seq_sum(&data[0], data.size(), SUM_KAHAN);
+    high = seq_sum(&data[0], data.size(), SUM_PAIRWISE);
+    if (total < 100000 - 1e-10 || total > 100000 + 1e-10
+        || high < 100000 - 1e-8 || high > 100000 + 1e-8)
+    {
+        cout << "Failed." << endl;
+        return 0;
+    }
+    cout << "Passed." << endl;
+
+    cout << "Checking the sequence's reductions and searches ... ";
+    cout.flush();
+    {
+        sequence s;
+        data.assign(37, 0.0);
+        fill_values(&data[0], 37, 99);
+        for (i = 0; i < 37; i++)
+            s.attach(data[i]);
+        s.start();
+        s.advance();
+        total = seq_sum(&data[0], 37);
+        for (i = j = 0; i < 37; i++)
+            if (data[i] > 0)
+                j++;
+        if (s.sum() != total || s.mean() != total / 37
+            || s.sum(SUM_KAHAN) != total || s.min() != seq_min(&data[0], 37)
+            || s.max() != seq_max(&data[0], 37)
+            || s.argmin() != seq_argmin(&data[0], 37)
+            || s.argmax() != seq_argmax(&data[0], 37)
+            || s.count_if([](double x) { return x > 0; }) != j
+            || s.find(data[36]) != seq_find(&data[0], 37, data[36])
+            || s.find_first_greater(0) != seq_find_first_greater(&data[0],
+                                                                 37, 0))
+        {
+            cout << "Failed." << endl;
+            return 0;
+        }
+        cout << "Passed." << endl;
+        if (!s.is_item() || s.current() != data[1])
+        {
+            cout << "The reductions moved the cursor." << endl;
+            return 0;
+        }
+    }
+
+    // All tests passed
+    cout << "All tests of this tenth function have been passed." << endl;
+    return POINTS[10];
+}
+
+// **************************************************************************
+// bool same_items(const sequence& test, const vector<double>& items,
+//                 size_t cursor_spot)
+//   Postcondition: A return value of true indicates that test holds
+//   exactly the items in items, in order, and that its cursor is at
+//   cursor_spot (or that it has no cursor if cursor_spot >= items.size()).
+//   Nothing is printed, and test is not changed (a copy is walked).
+// **************************************************************************
+bool same_items(const sequence& test, const vector<double>& items,
+                size_t cursor_spot)
+{
+    sequence walk(test);
+    size_t after = 0;   // Items from the cursor to the end
+    size_t i;
+
+    if (test.size() != items.size())
+        return false;
+    for ( ; walk.is_item(); walk.advance())
+        after++;
+    if ((cursor_spot < items.size()) ? (after != items.size() - cursor_spot)
+                                     : (after != 0))
+        return false;
+    for (walk.start(), i = 0; walk.is_item(); walk.advance(), i++)
+        if (walk.current() != items[i])
+            return false;
+    return true;
+}
+
+
+// **************************************************************************
+// int test11()
+//   Performs some tests of sort (which sorts on several threads from
+//   PARALLEL_SORT_MIN items, when there are several hardware threads) and
+//   of sorted mode, comparing with std::sort and with a vector kept in
+//   order by upper_bound.
+//   Returns POINTS[11] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test11()
+{
+    const size_t SIZES[] = { 0, 1, 2, 3, 4, 5, 17, 1000,
+                             PARALLEL_SORT_MIN - 1, PARALLEL_SORT_MIN,
+                             PARALLEL_SORT_MIN + 1, 3 * PARALLEL_SORT_MIN + 5 };
+    const size_t MANY_SIZES = sizeof(SIZES) / sizeof(SIZES[0]);
+    vector<double> data;
+    vector<double> expected;
+    size_t n;
+    size_t pos;
+    size_t i;
+    size_t j;
+
+    cout << "Checking seq_sort below and above PARALLEL_SORT_MIN ("
+         << PARALLEL_SORT_MIN << ") ... ";
+    cout.flush();
+    for (j = 0; j < MANY_SIZES + 2; j++)
+    {
+        n = (j < MANY_SIZES) ? SIZES[j] : PARALLEL_SORT_MIN + 3;
+        data.assign(n + 1, 0.0);
+        fill_values(&data[0], n, j + 11);
+        for (i = 0; i < n; i++)
+            if (j == MANY_SIZES)
+                data[i] = double(n - i);    // In reverse order
+            else if (j == MANY_SIZES + 1)
+                data[i] = 7;                // All the same
+        expected.assign(data.begin(), data.begin() + n);
+        std::sort(expected.begin(), expected.end());
+        seq_sort(&data[0], n);
+        if (!std::equal(expected.begin(), expected.end(), data.begin()))
+        {
+            cout << "\n    Sorting " << n << " items went wrong." << endl;
+            return 0;
+        }
+    }
+    cout << "Passed." << endl;
+
+    cout << "Sorting a sequence; the cursor keeps its position ... ";
+    cout.flush();
+    {
+        sequence s;
+        data.assign(50, 0.0);
+        fill_values(&data[0], 50, 5);
+        for (i = 0; i < 50; i++)
+            s.attach(data[i]);
+        s.start();
+        for (i = 0; i < 10; i++)
+            s.advance();
+        std::sort(data.begin(), data.end());
+        s.sort();
+        if (!same_items(s, data, 10))
+        {
+            cout << "Failed." << endl;
+            return 0;
+        }
+        cout << "Passed." << endl;
+    }
+
+    cout << "Inserting and attaching in sorted mode ... ";
+    cout.flush();
+    {
+        sequence s;
+        data.assign(240, 0.0);
+        fill_values(&data[0], 240, 3358);
+        for (i = 0; i < 40; i++)
+            s.insert(data[i]);
+        expected.assign(data.begin(), data.begin() + 40);
+        std::sort(expected.begin(), expected.end());
+        s.set_sorted(true);
+        if (!s.is_sorted_mode() || !same_items(s, expected, 0))
+        {
+            cout << "\n    set_sorted(true) did not sort the items." << endl;
+            return 0;
+        }
+        for (i = 40; i < 240; i++)
+        {
+            // Equal items come before the new one; the cursor is ignored.
+            s.start();
+            for (j = 0; j < i % 5 && s.is_item(); j++)
+                s.advance();
+            if (i % 2 == 0)
+                s.insert(data[i % 60]);
+            else
+                s.attach(data[i]);
+            pos = std::upper_bound(expected.begin(), expected.end(),
+                                   data[(i % 2 == 0) ? i % 60 : i])
+                  - expected.begin();
+            expected.insert(expected.begin() + pos,
+                            data[(i % 2 == 0) ? i % 60 : i]);
+            if (!same_items(s, expected, pos))
+            {
+                cout << "\n    Item " << i << " went to the wrong place."
+                     << endl;
+                return 0;
+            }
+        }
+        for (i = 0; i < 240; i++)
+        {
+            // The first equal item, or size() (some were not inserted).
+            pos = std::lower_bound(expected.begin(), expected.end(), data[i])
+                  - expected.begin();
+            if (pos < expected.size() && expected[pos] != data[i])
+                pos = expected.size();
+            if (s.find(data[i]) != pos)
+            {
+                cout << "\n    find went wrong in sorted mode." << endl;
+                return 0;
+            }
+        }
+        if (s.find(5000) != s.size() || s.find(-0.5) != s.size())
+        {
+            cout << "\n    find found an item that is not there." << endl;
+            return 0;
+        }
+        // Out of sorted mode, attach goes after the cursor again.
+        s.set_sorted(false);
+        s.start();
+        s.attach(5000);
+        expected.insert(expected.begin() + 1, 5000);
+        if (s.is_sorted_mode() || !same_items(s, expected, 1))
+        {
+            cout << "\n    set_sorted(false) did not end sorted mode." << endl;
+            return 0;
+        }
+        cout << "Passed." << endl;
+    }
+
+    cout << "Turning on sorted mode for " << PARALLEL_SORT_MIN + 1
+         << " items ... ";
+    cout.flush();
+    {
+        sequence s;
+        n = PARALLEL_SORT_MIN + 1;
+        data.assign(n, 0.0);
+        fill_values(&data[0], n, 1);
+        for (i = 0; i < n; i++)
+            s.attach(data[i]);
+        std::sort(data.begin(), data.end());
+        s.set_sorted(true);
+        if (!same_items(s, data, n - 1))
+        {
+            cout << "Failed." << endl;
+            return 0;
+        }
+        cout << "Passed." << endl;
+    }
+
+    // All tests passed
+    cout << "All tests of this eleventh function have been passed." << endl;
+    return POINTS[11];
+}
+
+// **************************************************************************
+// bool windows_correct(const vector<double>& data, size_t k, size_t step)
+//   Precondition: 1 <= k <= data.size() and step >= 1.
+//   Postcondition: seq_rolling_window has been called on data with windows
+//   of k items for each window_op, and its results compared with plain
+//   loops: every step-th window, and the last few. A return value of true
+//   indicates that all of them matched; otherwise the first window that
+//   did not match has been printed.
+// **************************************************************************
+bool windows_correct(const vector<double>& data, size_t k, size_t step)
+{
+    const window_op OPS[] = { WINDOW_SUM, WINDOW_MEAN, WINDOW_MIN,
+                              WINDOW_MAX };
+    size_t n = data.size();
+    vector<double> out(n - k + 1);
+    double expected;
+    size_t op;
+    size_t i;
+    size_t j;
+
+    for (op = 0; op < 4; op++)
+    {
+        seq_rolling_window(&data[0], &out[0], n, k, OPS[op]);
+        for (i = 0; i <= n - k; i += (i + step + 3 > n - k) ? 1 : step)
+        {
+            expected = data[i];
+            for (j = i + 1; j < i + k; j++)
+                if (OPS[op] == WINDOW_MIN)
+                    expected = (data[j] < expected) ? data[j] : expected;
+                else if (OPS[op] == WINDOW_MAX)
+                    expected = (data[j] > expected) ? data[j] : expected;
+                else
+                    expected += data[j];
+            if (OPS[op] == WINDOW_MEAN)
+                expected /= k;
+            if (out[i] != expected)
+            {
+                cout << "\n    Window " << i << " of length " << k << " of "
+                     << n << " items was wrong." << endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+
+// **************************************************************************
+// int test12()
+//   Performs some tests of the scans and rolling windows against plain
+//   loops: every length from 0 to 40 (for the tails of the vector scan),
+//   lengths around SCAN_BLOCK (where a scan is split into blocks) and
+//   PARALLEL_SCAN_MIN (where the blocks are spread over threads), and
+//   windows of every length for the short arrays.
+//   Returns POINTS[12] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test12()
+{
+    const size_t LONG_SIZES[] = { SCAN_BLOCK - 1, SCAN_BLOCK, SCAN_BLOCK + 1,
+                                  3 * SCAN_BLOCK + 7, PARALLEL_SCAN_MIN - 1,
+                                  PARALLEL_SCAN_MIN, PARALLEL_SCAN_MIN + 3 };
+    const size_t MANY_LONG = sizeof(LONG_SIZES) / sizeof(LONG_SIZES[0]);
+    const size_t LONG_WINDOWS[] = { 1, 2, 7, 1000, SCAN_BLOCK + 3 };
+    const size_t MANY_WINDOWS = sizeof(LONG_WINDOWS) / sizeof(LONG_WINDOWS[0]);
+    vector<double> data;
+    vector<double> expected;
+    vector<double> out;
+    double total;
+    size_t n;
+    size_t k;
+    size_t i;
+    size_t j;
+
+    cout << "Checking inclusive_scan and exclusive_scan (also in place)\n"
+         << "for lengths 0 to 40 and around SCAN_BLOCK and"
+         << " PARALLEL_SCAN_MIN ... ";
+    cout.flush();
+    for (j = 0; j <= 40 + MANY_LONG; j++)
+    {
+        n = (j <= 40) ? j : LONG_SIZES[j - 41];
+        data.assign(n + 1, 0.0);
+        expected.assign(n + 1, 0.0);
+        out.assign(n + 1, 0.0);
+        fill_values(&data[0], n, j + 35);
+        for (i = 0, total = 0.0; i < n; i++)
+            expected[i] = (total += data[i]);
+        seq_inclusive_scan(&data[0], &out[0], n);
+        if (out != expected)
+        {
+            cout << "\n    inclusive_scan of " << n << " items was wrong."
+                 << endl;
+            return 0;
+        }
+        for (i = 0, total = 0.5; i < n; i++)
+        {
+            expected[i] = total;
+            total += data[i];
+        }
+        seq_exclusive_scan(&data[0], &out[0], n, 0.5);
+        seq_exclusive_scan(&data[0], &data[0], n, 0.5);
+        if (out != expected || data != expected)
+        {
+            cout << "\n    exclusive_scan of " << n << " items was wrong."
+                 << endl;
+            return 0;
+        }
+    }
+    cout << "Passed." << endl;
+
+    cout << "Checking rolling_window for every window of lengths 1 to 40,\n"
+         << "and some windows of long arrays ... ";
+    cout.flush();
+    for (n = 1; n <= 40; n++)
+    {
+        data.assign(n, 0.0);
+        fill_values(&data[0], n, n + 53);
+        for (k = 1; k <= n; k++)
+            if (!windows_correct(data, k, 1))
+                return 0;
+    }
+    for (i = 0; i < MANY_LONG; i++)
+    {
+        data.assign(LONG_SIZES[i], 0.0);
+        fill_values(&data[0], LONG_SIZES[i], i + 94);
+        for (j = 0; j < MANY_WINDOWS && LONG_WINDOWS[j] <= data.size(); j++)
+            if (!windows_correct(data, LONG_WINDOWS[j],
+                                 (LONG_WINDOWS[j] < 10) ? 1 : 97))
+                return 0;
+    }
+    cout << "Passed." << endl;
+
+    cout << "Checking the sequence's scans and rolling windows ... ";
+    cout.flush();
+    {
+        sequence s;
+        data.assign(30, 0.0);
+        fill_values(&data[0], 30, 7);
+        for (i = 0; i < 30; i++)
+            s.attach(data[i]);
+        s.start();
+        out.assign(30, 0.0);
+        seq_inclusive_scan(&data[0], &out[0], 30);
+        if (!same_items(s.inclusive_scan(), out, 30))
+        {
+            cout << "Failed for inclusive_scan." << endl;
+            return 0;
+        }
+        seq_exclusive_scan(&data[0], &out[0], 30, 2);
+        if (!same_items(s.exclusive_scan(2), out, 30))
+        {
+            cout << "Failed for exclusive_scan." << endl;
+            return 0;
+        }
+        out.assign(30 - 6 + 1, 0.0);
+        seq_rolling_window(&data[0], &out[0], 30, 6, WINDOW_MAX);
+        if (!same_items(s.rolling_window(6, WINDOW_MAX), out, 30)
+            || !same_items(s, data, 0))
+        {
+            cout << "Failed for rolling_window." << endl;
+            return 0;
+        }
+        cout << "Passed." << endl;
+    }
+
+    // All tests passed
+    cout << "All tests of this twelfth function have been passed." << endl;
+    return POINTS[12];
+}
+
+// **************************************************************************
+// bool same_bits(const sequence& test, const vector<double>& items)
+//   Postcondition: A return value of true indicates that test holds
+//   exactly the items in items, in order, each with the same bits (so
+//   -0.0 is not taken for 0.0). Nothing is printed, and test is not
+//   changed (a copy is walked).
+// **************************************************************************
+bool same_bits(const sequence& test, const vector<double>& items)
+{
+    sequence walk(test);
+    double x;
+    size_t i;
+
+    if (test.size() != items.size())
+        return false;
+    for (walk.start(), i = 0; walk.is_item(); walk.advance(), i++)
+    {
+        x = walk.current();
+        if (memcmp(&x, &items[i], sizeof(double)) != 0)
+            return false;
+    }
+    return true;
+}
+
+
+// **************************************************************************
+// int test13()
+//   Performs some tests of save_text/load_text and save/load: items that
+//   are hard to print (-0.0, the smallest and largest doubles, 0.1, 1/3)
+//   and enough of them to fill several of the blocks read at a time must
+//   come back with the same bits; text with commas and a '+' must be read;
+//   and a bad number in text, or a binary file cut short, must set failbit
+//   and keep the items read before it.
+//   Returns POINTS[13] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test13()
+{
+    const size_t MANY = 300000;     // Several blocks of text and of binary
+    const double HARD[] = { 0.0, -0.0, 0.1, 1.0 / 3, -1.5, 1e308,
+                            1.7976931348623157e308, 2.2250738585072014e-308,
+                            4.9406564584124654e-324, 3.141592653589793,
+                            123456789012345678.0, -2.5e-10 };
+    const size_t MANY_HARD = sizeof(HARD) / sizeof(HARD[0]);
+    vector<double> items;
+    vector<double> first;   // The items before a bad number
+    string bytes;
+    size_t i;
+
+    for (i = 0; i < MANY; i++)
+        items.push_back((i < MANY_HARD) ? HARD[i]
+                        : (i % 3 == 0) ? 1.0 / double(i) : double(i) * 1e-3);
+
+    cout << "Saving " << MANY << " items as text and loading them ... ";
+    cout.flush();
+    {
+        sequence original;
+        sequence copy;
+        stringstream text;
+        for (i = 0; i < MANY; i++)
+            original.attach(items[i]);
+        original.save_text(text);
+        if (copy.load_text(text) != MANY || text.fail()
+            || !same_bits(copy, items) || copy.is_item())
+        {
+            cout << "Failed." << endl;
+            return 0;
+        }
+        cout << "Passed." << endl;
+
+        cout << "Saving them in binary and loading them after 2 items,\n"
+             << "with the cursor on the first ... ";
+        cout.flush();
+        stringstream binary(ios::in | ios::out | ios::binary);
+        original.save(binary);
+        bytes = binary.str();
+        if (bytes.size() != 8 + MANY * sizeof(double))
+        {
+            cout << "\n    The file is " << bytes.size() << " bytes long."
+                 << endl;
+            return 0;
+        }
+        sequence added;
+        added.attach(-7);
+        added.attach(-8);
+        added.start();
+        first.assign(1, -7);
+        first.push_back(-8);
+        first.insert(first.end(), items.begin(), items.end());
+        if (added.load(binary) != MANY || binary.fail()
+            || !same_bits(added, first) || !added.is_item()
+            || added.current() != -7)
+        {
+            cout << "Failed." << endl;
+            return 0;
+        }
+        cout << "Passed." << endl;
+    }
+
+    cout << "Loading text with commas, tabs and a '+' ... ";
+    cout.flush();
+    {
+        sequence s;
+        istringstream text("1,2 ,\n+3\t4e2,,-0.5\n");
+        first.assign(1, 1);
+        first.push_back(2);
+        first.push_back(3);
+        first.push_back(400);
+        first.push_back(-0.5);
+        if (s.load_text(text) != 5 || text.fail() || !same_bits(s, first))
+        {
+            cout << "Failed." << endl;
+            return 0;
+        }
+        cout << "Passed." << endl;
+    }
+
+    cout << "Loading text with a bad number; the ones before it are kept ... ";
+    cout.flush();
+    {
+        sequence s;
+        sequence t;
+        istringstream bad_word("1 2 abc 4\n");
+        istringstream bad_end("5 6.5x 7");
+        first.assign(1, 1);
+        first.push_back(2);
+        if (s.load_text(bad_word) != 2 || !bad_word.fail()
+            || !same_bits(s, first))
+        {
+            cout << "Failed for a word." << endl;
+            return 0;
+        }
+        first.assign(1, 5);
+        if (t.load_text(bad_end) != 1 || !bad_end.fail()
+            || !same_bits(t, first))
+        {
+            cout << "Failed for a number followed by a letter." << endl;
+            return 0;
+        }
+        cout << "Passed." << endl;
+    }
+
+    cout << "Loading a binary file cut short; the whole items are kept ... ";
+    cout.flush();
+    {
+        sequence s;
+        sequence t;
+        istringstream part(bytes.substr(0, 8 + 10 * sizeof(double) + 3),
+                           ios::in | ios::binary);
+        istringstream header(bytes.substr(0, 3), ios::in | ios::binary);
+        first.assign(items.begin(), items.begin() + 10);
+        if (s.load(part) != 10 || !part.fail() || !same_bits(s, first))
+        {
+            cout << "Failed." << endl;
+            return 0;
+        }
+        if (t.load(header) != 0 || !header.fail() || t.size() != 0)
+        {
+            cout << "Failed for a file with only part of the count." << endl;
+            return 0;
+        }
+        cout << "Passed." << endl;
+    }
+
+    cout << "Loading text into a sorted sequence ... ";
+    cout.flush();
+    {
+        sequence s;
+        istringstream text("5 -1 3 3 0");
+        s.set_sorted(true);
+        s.attach(2);
+        first.assign(1, -1);
+        first.push_back(0);
+        first.push_back(2);
+        first.push_back(3);
+        first.push_back(3);
+        first.push_back(5);
+        if (s.load_text(text) != 5 || !same_items(s, first, first.size()))
+        {
+            cout << "Failed." << endl;
+            return 0;
+        }
+        cout << "Passed." << endl;
+    }
+
+    // All tests passed
+    cout << "All tests of this thirteenth function have been passed." << endl;
+    return POINTS[13];
+}
+
+// **************************************************************************
+// bool chunked_holds(const chunked_sequence& test,
+//                    const vector<double>& items, vector<size_t>& runs)
+//   Postcondition: A return value of true indicates that test holds
+//   exactly the items in items, in order. runs has been set to the
+//   lengths of the runs of items stored at consecutive addresses, which
+//   are the counts of the blocks (separate blocks are never adjacent,
+//   since each begins with its count). Nothing is printed, and test is
+//   not changed (a copy is walked).
+// **************************************************************************
+bool chunked_holds(const chunked_sequence& test, const vector<double>& items,
+                   vector<size_t>& runs)
+{
+    chunked_sequence walk(test);
+    const double* last = NULL;
+    size_t i;
+
+    runs.clear();
+    if (test.size() != items.size())
+        return false;
+    for (walk.start(), i = 0; walk.is_item(); walk.advance(), i++)
+    {
+        if (i >= items.size() || walk.current() != items[i])
+            return false;
+        if (last != NULL && walk.current_address() == last + 1)
+            ++runs.back();
+        else
+            runs.push_back(1);
+        last = walk.current_address();
+    }
+    return i == items.size();
+}
+
+
+// **************************************************************************
+// int test14()
+//   Performs some tests of removing items from a chunked_sequence: every
+//   other item of several full blocks, items near the end of a block
+//   (where the cursor moves on to the next block as they merge), and many
+//   random inserts, attaches and removals, checked against a vector. After
+//   the removals, no two neighboring blocks may both be at most half full.
+//   Returns POINTS[14] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test14()
+{
+    const size_t B = chunked_sequence::BLOCK_SIZE;
+    vector<double> items;
+    vector<size_t> runs;
+    size_t i;
+    size_t k;
+    unsigned int state = 3358;
+
+    cout << "Removing every other item of 4 full blocks ... ";
+    cout.flush();
+    {
+        chunked_sequence s;
+        for (i = 0; i < 4 * B; i++)
+        {
+            s.attach(double(i));
+            if (i % 2 == 1)
+                items.push_back(double(i));
+        }
+        s.start();
+        for (i = 0; i < 4 * B; i += 2)
+        {
+            if (!s.is_item() || s.current() != double(i))
+            {
+                cout << "Failed." << endl;
+                return 0;
+            }
+            s.remove_current();
+            if (!s.is_item() || s.current() != double(i + 1))
+            {
+                cout << "Failed." << endl;
+                return 0;
+            }
+            s.advance();
+        }
+        if (s.is_item() || !chunked_holds(s, items, runs)
+            || runs.size() != 2 || runs[0] != B || runs[1] != B)
+        {
+            cout << "Failed (the half-full blocks were not merged)." << endl;
+            return 0;
+        }
+        cout << "Passed." << endl;
+
+        cout << "Removing the last items of blocks, then every item ... ";
+        cout.flush();
+        // Emptying the second half of the first block leaves the cursor on
+        // the second block; removing half of that merges what is left of
+        // it onto the first block, and the cursor must follow its item.
+        s.start();
+        for (i = 0; i < B / 2; i++)
+            s.advance();
+        for (i = 0; i < B / 2; i++)
+            s.remove_current();
+        items.erase(items.begin() + B / 2, items.begin() + B);
+        for (i = 0; i < B / 2; i++)
+            s.remove_current();
+        items.erase(items.begin() + B / 2, items.begin() + B);
+        if (!s.is_item() || s.current() != items[B / 2]
+            || !chunked_holds(s, items, runs)
+            || runs.size() != 1 || runs[0] != B)
+        {
+            cout << "Failed." << endl;
+            return 0;
+        }
+        while (s.is_item())
+            s.remove_current();
+        s.start();
+        while (s.is_item())
+            s.remove_current();
+        items.clear();
+        if (s.size() != 0 || !chunked_holds(s, items, runs))
+        {
+            cout << "Failed." << endl;
+            return 0;
+        }
+        s.attach(1.5);
+        items.push_back(1.5);
+        if (!chunked_holds(s, items, runs) || s.current() != 1.5)
+        {
+            cout << "Failed." << endl;
+            return 0;
+        }
+        cout << "Passed." << endl;
+    }
+
+    cout << "Random inserts, attaches and removals ... ";
+    cout.flush();
+    {
+        chunked_sequence s;
+        size_t at = 0;      // Position of the current item in items
+        items.clear();
+        for (k = 0; k < 40000; k++)
+        {
+            state = state * 1103515245u + 12345u;
+            i = (state >> 8) % 16;
+            if (i < 3 && s.size() > 0)
+            {                           // Move the cursor
+                s.start();
+                at = (state >> 12) % s.size();
+                for (i = 0; i < at; i++)
+                    s.advance();
+            }
+            else if (i < 7 || ((k / 10000) % 2 == 1 && i < 14))
+            {                           // Remove (mostly in the odd 10000s)
+                if (s.is_item())
+                {
+                    s.remove_current();
+                    items.erase(items.begin() + at);
+                }
+            }
+            else if (i < 11)
+            {
+                s.insert(double(k));
+                if (at >= items.size())
+                    at = 0;
+                items.insert(items.begin() + at, double(k));
+            }
+            else
+            {
+                s.attach(double(k));
+                at = (at >= items.size()) ? items.size() : at + 1;
+                items.insert(items.begin() + at, double(k));
+            }
+            if (s.is_item() != (at < items.size())
+                || (s.is_item() && s.current() != items[at]))
+            {
+                cout << "Failed (wrong current item)." << endl;
+                return 0;
+            }
+            if (k % 97 == 0 && !chunked_holds(s, items, runs))
+            {
+                cout << "Failed." << endl;
+                return 0;
+            }
+        }
+        chunked_sequence copy(s);
+        if (!chunked_holds(copy, items, runs))
+        {
+            cout << "Failed (the copy)." << endl;
+            return 0;
+        }
+        cout << "Passed." << endl;
+    }
+
+    // All tests passed
+    cout << "All tests of this fourteenth function have been passed." << endl;
+    return POINTS[14];
+}
+
+// **************************************************************************
+// bool view_matches(const sequence_view& v, const vector<double>& items)
+//   Postcondition: A return value of true indicates that v holds exactly
+//   the items in items, in order: by size, operator [], its
+//   iterators and its cursor; and that each reduction and search of v
+//   gives what the same one gives for a sequence built from a copy of
+//   items (and, for the sums, what a plain loop gives; the items are whole
+//   numbers, so every order of adding gives the same sum). Nothing is
+//   printed.
+// **************************************************************************
+bool view_matches(const sequence_view& v, const vector<double>& items)
+{
+    const double THRESHOLDS[] = { -2000, -500, 0, 500, 999, 2000 };
+    sequence_view walk(v);
+    sequence copy;
+    sequence_view::const_iterator it;
+    double total = 0.0;
+    size_t i;
+
+    if (v.size() != items.size())
+        return false;
+    for (i = 0; i < items.size(); i++)
+    {
+        copy.attach(items[i]);
+        total += items[i];
+        if (v[i] != items[i])
+            return false;
+    }
+    for (it = v.begin(), i = 0; it != v.end(); ++it, i++)
+        if (i >= items.size() || *it != items[i])
+            return false;
+    if (i != items.size() || walk.is_item())
+        return false;
+    for (walk.start(), i = 0; walk.is_item(); walk.advance(), i++)
+        if (i >= items.size() || walk.current() != items[i])
+            return false;
+    if (i != items.size())
+        return false;
+
+    if (v.sum() != total || v.sum(SUM_KAHAN) != total
+        || v.sum(SUM_PAIRWISE) != total || copy.sum() != total)
+        return false;
+    for (i = 0; i < sizeof(THRESHOLDS) / sizeof(THRESHOLDS[0]); i++)
+    {
+        double t = THRESHOLDS[i];
+        auto above = [t](double x) { return x > t; };
+        if (v.find_first_greater(t) != copy.find_first_greater(t)
+            || v.count_if(above) != copy.count_if(above))
+            return false;
+    }
+    if (items.empty())
+        return true;
+    return v.mean() == copy.mean() && v.min() == copy.min()
+        && v.max() == copy.max() && v.argmin() == copy.argmin()
+        && v.argmax() == copy.argmax();
+}
+
+
+// **************************************************************************
+// int test15()
+//   Performs some tests of sequence_view: views of a sequence with
+//   strides 1 to 9 and starts and lengths that stop short of, and reach,
+//   the last item; slices of those views (themselves strided); and views
+//   of no items. Each is checked against a copy of the items it should
+//   hold, by view_matches.
+//   Returns POINTS[15] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test15()
+{
+    const size_t N = 1000;
+    const size_t STARTS[] = { 0, 1, 3, 517 };
+    double data[N];
+    sequence s;
+    vector<double> items;
+    vector<double> part;
+    size_t start;
+    size_t stride;
+    size_t count;
+    size_t i;
+    size_t j;
+
+    fill_values(data, N, 15);
+    for (i = 0; i < N; i++)
+        s.attach(data[i]);
+
+    cout << "Views with strides 1 to 9 from several starts ... ";
+    cout.flush();
+    for (j = 0; j < sizeof(STARTS) / sizeof(STARTS[0]); j++)
+        for (stride = 1; stride <= 9; stride++)
+        {
+            // Every item from start that fits, then one fewer, then a
+            // few (fewer than one vector of the kernels, and a tail).
+            start = STARTS[j];
+            const size_t COUNTS[] = { (N - 1 - start) / stride + 1,
+                                      (N - 1 - start) / stride, 3, 6 };
+            for (i = 0; i < sizeof(COUNTS) / sizeof(COUNTS[0]); i++)
+            {
+                count = COUNTS[i];
+                items.clear();
+                for (size_t k = 0; k < count; k++)
+                    items.push_back(data[start + k * stride]);
+                sequence_view v = s.view(start, count, stride);
+                if (v.stride() != stride || !view_matches(v, items))
+                {
+                    cout << "Failed." << endl;
+                    return 0;
+                }
+            }
+        }
+    cout << "Passed." << endl;
+
+    cout << "Slices of views, and views of no items ... ";
+    cout.flush();
+    {
+        sequence_view whole = s.view();
+        sequence_view odd = s.view(1, N / 2, 2);
+        items.assign(data, data + N);
+        if (!view_matches(whole, items))
+        {
+            cout << "Failed (the whole sequence)." << endl;
+            return 0;
+        }
+        for (stride = 1; stride <= 7; stride++)
+        {
+            // Items 3, 3 + stride, ... of odd are items 7, 7 + 2 * stride,
+            // ... of the sequence.
+            count = (N / 2 - 1 - 3) / stride + 1;
+            part.clear();
+            for (i = 0; i < count; i++)
+                part.push_back(data[7 + 2 * stride * i]);
+            sequence_view v = odd.slice(3, count, stride);
+            if (v.stride() != 2 * stride || !view_matches(v, part))
+            {
+                cout << "Failed." << endl;
+                return 0;
+            }
+            // A slice of the slice.
+            part.erase(part.begin());
+            if (part.size() > 2)
+                part.resize(part.size() - 2);
+            if (!view_matches(v.slice(1, part.size()), part))
+            {
+                cout << "Failed." << endl;
+                return 0;
+            }
+        }
+        part.clear();
+        if (!view_matches(s.view(5, 0, 3), part)
+            || !view_matches(odd.slice(2, 0, 4), part)
+            || !view_matches(sequence_view(), part))
+        {
+            cout << "Failed (a view of no items)." << endl;
+            return 0;
+        }
+    }
+    cout << "Passed." << endl;
+
+    // All tests passed
+    cout << "All tests of this fifteenth function have been passed." << endl;
+    return POINTS[15];
+}
+
 int run_a_test(int number, const char message[], int test_function(), int max)
 {
     int result;
@@ -763,6 +2069,14 @@ int main()
     sum += run_a_test(5, DESCRIPTION[5], test5, POINTS[5]);
     sum += run_a_test(6, DESCRIPTION[6], test6, POINTS[6]);
     sum += run_a_test(7, DESCRIPTION[7], test7, POINTS[7]);
+    sum += run_a_test(8, DESCRIPTION[8], test8, POINTS[8]);
+    sum += run_a_test(9, DESCRIPTION[9], test9, POINTS[9]);
+    sum += run_a_test(10, DESCRIPTION[10], test10, POINTS[10]);
+    sum += run_a_test(11, DESCRIPTION[11], test11, POINTS[11]);
+    sum += run_a_test(12, DESCRIPTION[12], test12, POINTS[12]);
+    sum += run_a_test(13, DESCRIPTION[13], test13, POINTS[13]);
+    sum += run_a_test(14, DESCRIPTION[14], test14, POINTS[14]);
+    sum += run_a_test(15, DESCRIPTION[15], test15, POINTS[15]);
 
     cout << "Your sequence implementation has scored\n";
     cout << sum << " points out of the " << POINTS[0];
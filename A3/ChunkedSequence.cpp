@@ -0,0 +1,300 @@
+// FILE: ChunkedSequence.cpp
+// CLASS IMPLEMENTED: chunked_sequence (see ChunkedSequence.h for
+//   documentation)
+// INVARIANT for the chunked_sequence ADT:
+//   1. dir is an array of dir_capacity block addresses (NULL when
+//      dir_capacity is 0), of which dir[0] through dir[blocks - 1] are
+//      in use. Each of those blocks was allocated with new and holds
+//      from 1 to BLOCK_SIZE items in items[0] through items[count - 1].
+//   2. The items of the sequence are those of dir[0], then dir[1], and
+//      so on; used is the total of the blocks' counts.
+//   3. If there is a current item it is dir[cur_block]->items[cur_offset]
+//      (so cur_block < blocks and cur_offset < dir[cur_block]->count).
+//      cur_block == blocks means there is no current item, and then
+//      cur_offset is 0.
+//   4. Items only ever move within a block, from the end of a full
+//      block into a new block placed right after it (in put), or from a
+//      block onto the end of the block before it (in merge_blocks).
+//      Adding at the very start or end of a full block moves nothing.
+//   5. After remove_current, the block it removed from and the next (or
+//      else the previous) block are not both at most half full.
+
+#include <cassert>
+#include <cstring>  // provides memcpy, memmove
+#include "ChunkedSequence.h"
+
+namespace CS3358_Sp2016
+{
+   // CONSTRUCTORS and DESTRUCTOR
+   chunked_sequence::chunked_sequence()
+      :dir(NULL), blocks(0), dir_capacity(0), used(0), cur_block(0),
+       cur_offset(0)
+   {
+   }
+
+   chunked_sequence::chunked_sequence(const chunked_sequence& source)
+      :dir(NULL), blocks(0), dir_capacity(0), used(0), cur_block(0),
+       cur_offset(0)
+   {
+      copy_blocks(source);
+   }
+
+   chunked_sequence::~chunked_sequence()
+   {
+      free_blocks();
+   }
+
+   // MODIFICATION MEMBER FUNCTIONS
+   void chunked_sequence::start()
+   {
+      cur_block = 0;
+      cur_offset = 0;
+   }
+
+   void chunked_sequence::advance()
+   {
+      if (!is_item())
+         return;
+      if (++cur_offset == dir[cur_block]->count)
+      {                          //Past the end of this block.
+         ++cur_block;
+         cur_offset = 0;
+      }
+   }
+
+   void chunked_sequence::insert(const value_type& entry)
+   {
+      if (blocks == 0)
+         add_block(0);
+      if (!is_item())
+         put(0, 0, entry);//No current item: insert at front.
+      else
+         put(cur_block, cur_offset, entry);
+   }
+
+   void chunked_sequence::attach(const value_type& entry)
+   {
+      if (blocks == 0)
+         add_block(0);
+      if (!is_item())
+         put(blocks - 1, dir[blocks - 1]->count, entry);//At the end.
+      else
+         put(cur_block, cur_offset + 1, entry);
+   }
+
+   void chunked_sequence::remove_current()
+   {
+      if (!is_item())
+         return;
+
+      size_type b = cur_block;
+      block* here = dir[b];
+      std::memmove(here->items + cur_offset, here->items + cur_offset + 1,
+                   (here->count - cur_offset - 1) * sizeof(value_type));
+      --here->count;
+      --used;
+      if (here->count == 0)
+      {
+         remove_block(b);       //The next block slides into cur_block.
+         return;
+      }
+      if (cur_offset == here->count)
+      {
+         ++cur_block;
+         cur_offset = 0;
+      }
+      if (here->count <= BLOCK_SIZE / 2)
+      {                         //Merge with a neighbor that is as empty.
+         if (b + 1 < blocks && dir[b + 1]->count <= BLOCK_SIZE / 2)
+            merge_blocks(b);
+         else if (b > 0 && dir[b - 1]->count <= BLOCK_SIZE / 2)
+            merge_blocks(b - 1);
+      }
+   }
+
+   chunked_sequence& chunked_sequence::operator=
+      (const chunked_sequence& source)
+   {
+      if (this == &source)
+         return *this;
+
+      chunked_sequence copy(source);//Copies before freeing our blocks.
+      free_blocks();
+      dir = copy.dir;
+      blocks = copy.blocks;
+      dir_capacity = copy.dir_capacity;
+      used = copy.used;
+      cur_block = copy.cur_block;
+      cur_offset = copy.cur_offset;
+      copy.dir = NULL;
+      copy.blocks = copy.dir_capacity = 0;
+      return *this;
+   }
+
+   void chunked_sequence::add_block(size_type at)
+   {
+      //Puts a new, empty block at dir[at]. Only block addresses move.
+      block* fresh = new block;
+      fresh->count = 0;
+
+      if (blocks == dir_capacity)
+      {
+         size_type new_capacity = (dir_capacity == 0) ? 8 : 2 * dir_capacity;
+         block** new_dir;
+         try
+         {
+            new_dir = new block*[new_capacity];
+         }
+         catch (...)
+         {
+            delete fresh;
+            throw;
+         }
+         if (blocks > 0)
+            std::memcpy(new_dir, dir, blocks * sizeof(block*));
+         delete [] dir;
+         dir = new_dir;
+         dir_capacity = new_capacity;
+      }
+      std::memmove(dir + at + 1, dir + at, (blocks - at) * sizeof(block*));
+      dir[at] = fresh;
+      ++blocks;
+      if (cur_block >= at && cur_block < blocks - 1)
+         ++cur_block;           //The current item's block moved up one.
+      else if (cur_block == blocks - 1)
+         cur_block = blocks;    //Still no current item.
+   }
+
+   void chunked_sequence::remove_block(size_type at)
+   {
+      delete dir[at];
+      std::memmove(dir + at, dir + at + 1,
+                   (blocks - at - 1) * sizeof(block*));
+      --blocks;
+   }
+
+   void chunked_sequence::merge_blocks(size_type first)
+   {
+      //Pre: first + 1 < blocks, and the two blocks hold at most
+      //  BLOCK_SIZE items between them.
+      //Post: The items of block first + 1 follow those of block first,
+      //  and block first + 1 has been removed. The cursor is on the same
+      //  item as before.
+      block* front = dir[first];
+      block* back = dir[first + 1];
+
+      std::memcpy(front->items + front->count, back->items,
+                  back->count * sizeof(value_type));
+      if (cur_block == first + 1)
+      {
+         cur_block = first;
+         cur_offset += front->count;
+      }
+      else if (cur_block > first + 1)
+         --cur_block;           //Also keeps cur_block == blocks.
+      front->count += back->count;
+      remove_block(first + 1);
+   }
+
+   void chunked_sequence::put(size_type b, size_type offset,
+                              const value_type& entry)
+   {
+      //Pre: b < blocks and offset <= dir[b]->count.
+      //Post: entry is at position offset of block b (or at the start of
+      //  a new block after it) and is the current item.
+      value_type hold = entry;//entry may be one of the items.
+      block* here = dir[b];
+
+      if (here->count == BLOCK_SIZE && offset == 0)
+      {
+         add_block(b);          //Before the start: a new block in front.
+         here = dir[b];
+      }
+      else if (here->count == BLOCK_SIZE)
+      {
+         add_block(b + 1);
+         block* next = dir[b + 1];
+         if (offset == BLOCK_SIZE)
+         {
+            b = b + 1;          //Past the end: start the new block.
+            here = next;
+            offset = 0;
+         }
+         else
+         {                      //Move the tail of the full block out.
+            next->count = BLOCK_SIZE - offset;
+            std::memcpy(next->items, here->items + offset,
+                        next->count * sizeof(value_type));
+            here->count = offset;
+         }
+      }
+      std::memmove(here->items + offset + 1, here->items + offset,
+                   (here->count - offset) * sizeof(value_type));
+      here->items[offset] = hold;
+      ++here->count;
+      ++used;
+      cur_block = b;
+      cur_offset = offset;
+   }
+
+   void chunked_sequence::copy_blocks(const chunked_sequence& source)
+   {
+      //Pre: this sequence holds no blocks.
+      if (source.blocks == 0)
+         return;
+
+      dir = new block*[source.blocks];
+      dir_capacity = source.blocks;
+      try
+      {
+         for (blocks = 0; blocks < source.blocks; ++blocks)
+         {
+            dir[blocks] = new block;
+            dir[blocks]->count = source.dir[blocks]->count;
+            std::memcpy(dir[blocks]->items, source.dir[blocks]->items,
+                        source.dir[blocks]->count * sizeof(value_type));
+         }
+      }
+      catch (...)
+      {
+         free_blocks();
+         throw;
+      }
+      used = source.used;
+      cur_block = source.cur_block;
+      cur_offset = source.cur_offset;
+   }
+
+   void chunked_sequence::free_blocks()
+   {
+      for (size_type b = 0; b < blocks; ++b)
+         delete dir[b];
+      delete [] dir;
+      dir = NULL;
+      blocks = dir_capacity = used = cur_block = cur_offset = 0;
+   }
+
+   // CONSTANT MEMBER FUNCTIONS
+   chunked_sequence::size_type chunked_sequence::size() const
+   {
+      return used;
+   }
+
+   bool chunked_sequence::is_item() const
+   {
+      return cur_block < blocks;
+   }
+
+   chunked_sequence::value_type chunked_sequence::current() const
+   {
+      assert(is_item());
+      return dir[cur_block]->items[cur_offset];
+   }
+
+   const chunked_sequence::value_type*
+      chunked_sequence::current_address() const
+   {
+      assert(is_item());
+      return dir[cur_block]->items + cur_offset;
+   }
+}
@@ -0,0 +1,115 @@
+// FILE: ChunkedSequence.h
+// CLASS PROVIDED: chunked_sequence (part of the namespace CS3358_Sp2016)
+//   A sequence of doubles, with the same cursor interface as sequence
+//   (see Sequence.h), whose items are kept in fixed-size blocks of
+//   BLOCK_SIZE items rather than in one array. A directory holds the
+//   blocks' addresses in order. Growing the sequence allocates a new
+//   block and, now and then, a larger directory, but never copies the
+//   items already stored, so there is no O(n) pause like sequence's
+//   resize, and items stay at the same address:
+//     - An insert, attach or remove_current moves only those items of
+//       the one block it changes that come after the position changed.
+//       (When that block is full, those items move to a new block
+//       placed after it; adding at the very start or end of a full
+//       block starts a new block instead.) Items in every other block
+//       never move.
+//     - When remove_current leaves its block at most half full and the
+//       next block (or else the previous one) is at most half full too,
+//       the later block's items are moved onto the end of the earlier
+//       one and the later block is freed. So removing many items does
+//       not leave a long run of nearly empty blocks to walk through.
+//     - In particular attach at the end of the sequence moves nothing,
+//       so the address of every item stays valid while appending.
+//
+// TYPEDEFS and MEMBER CONSTANTS for the chunked_sequence class:
+//   typedef double value_type
+//   typedef std::size_t size_type
+//     As for sequence.
+//
+//   static const size_type BLOCK_SIZE = _____
+//     chunked_sequence::BLOCK_SIZE is the number of items in a block.
+//
+// CONSTRUCTOR for the chunked_sequence class:
+//   chunked_sequence()
+//    Post: The sequence is empty. No memory is allocated until the
+//      first item is added.
+//
+// MODIFICATION MEMBER FUNCTIONS for the chunked_sequence class:
+//   void start(), void advance(), void insert(const value_type& entry),
+//   void attach(const value_type& entry), void remove_current()
+//    As for sequence. All are O(BLOCK_SIZE) at most, plus O(number of
+//    blocks) pointer moves when a block is added, merged or freed.
+//
+// CONSTANT MEMBER FUNCTIONS for the chunked_sequence class:
+//   size_type size() const, bool is_item() const,
+//   value_type current() const
+//    As for sequence.
+//
+//   const value_type* current_address() const
+//    Pre:  is_item returns true.
+//    Post: The return value is the address of the current item. It
+//      stays valid, pointing to that item, until the item is removed or
+//      moved as described above.
+//
+// VALUE SEMANTICS for the chunked_sequence class:
+//   Assignments and the copy constructor may be used with
+//   chunked_sequence objects; the copy has blocks of its own.
+//
+// DYNAMIC MEMORY USAGE by the chunked_sequence class:
+//   If there is insufficient dynamic memory, the following functions
+//   throw bad_alloc: the copy constructor, insert, attach and operator=.
+
+#ifndef CHUNKEDSEQUENCE_H
+#define CHUNKEDSEQUENCE_H
+#include <cstdlib>  // provides size_t
+
+namespace CS3358_Sp2016
+{
+   class chunked_sequence
+   {
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef double value_type;
+      typedef std::size_t size_type;
+      static const size_type BLOCK_SIZE = 512;
+      // CONSTRUCTORS and DESTRUCTOR
+      chunked_sequence();
+      chunked_sequence(const chunked_sequence& source);
+      ~chunked_sequence();
+      // MODIFICATION MEMBER FUNCTIONS
+      void start();
+      void advance();
+      void insert(const value_type& entry);
+      void attach(const value_type& entry);
+      void remove_current();
+      chunked_sequence& operator=(const chunked_sequence& source);
+      // CONSTANT MEMBER FUNCTIONS
+      size_type size() const;
+      bool is_item() const;
+      value_type current() const;
+      const value_type* current_address() const;
+   private:
+      struct block
+      {
+         size_type count;               // Items in use, 1 to BLOCK_SIZE
+         value_type items[BLOCK_SIZE];
+      };
+
+      // HELPER MEMBER FUNCTIONS
+      void add_block(size_type at);
+      void remove_block(size_type at);
+      void merge_blocks(size_type first);
+      void put(size_type b, size_type offset, const value_type& entry);
+      void copy_blocks(const chunked_sequence& source);
+      void free_blocks();
+
+      block** dir;              // Addresses of the blocks, in order
+      size_type blocks;         // Number of blocks in dir
+      size_type dir_capacity;   // Number of slots in dir
+      size_type used;           // Number of items
+      size_type cur_block;      // Block of the current item
+      size_type cur_offset;     // Its position within that block
+   };
+}
+
+#endif
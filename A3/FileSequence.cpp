@@ -0,0 +1,270 @@
+// FILE: FileSequence.cpp
+// CLASS IMPLEMENTED: file_sequence (see FileSequence.h for documentation)
+// INVARIANT for the file_sequence ADT:
+//   1. fd is the open file; base..base+mapped is a shared, writable
+//      mapping of the start of the file (normally all of it; only a
+//      resize that failed part way leaves the file longer).
+//   2. head points to the header at base; data points just past it. The
+//      number of items, the capacity and the cursor are kept in the
+//      header (head->used, head->capacity, head->current_index) rather
+//      than in member variables, so that they are saved with the items.
+//   3. mapped >= sizeof(header) + head->capacity * sizeof(value_type),
+//      and head->capacity >= 1. The two are equal except after a resize
+//      that was interrupted (see resize): the capacity in the header is
+//      never more than the file holds, so such a file still opens.
+//   4. The items are data[0] through data[head->used - 1]. As in
+//      sequence, head->current_index == head->used means there is no
+//      current item.
+
+#include <cassert>
+#include <cerrno>        // provides errno
+#include <cstring>       // provides memcmp, memcpy, memmove
+#include <cstdint>       // provides SIZE_MAX
+#include <stdexcept>     // provides runtime_error, length_error
+#include <system_error>  // provides system_error, generic_category
+#include <fcntl.h>       // provides open
+#include <sys/mman.h>    // provides mmap, mremap, msync, munmap
+#include <sys/stat.h>    // provides fstat
+#include <unistd.h>      // provides ftruncate, close
+#include "FileSequence.h"
+
+namespace CS3358_Sp2016
+{
+   namespace
+   {
+      const char MAGIC[8] = { 'S', 'E', 'Q', 'D', 'B', 'L', '0', '1' };
+
+      void fail(const char* what)
+      {
+         throw std::system_error(errno, std::generic_category(), what);
+      }
+
+      void close_and_fail(int fd, const char* what)
+      {
+         int error = errno;//Saved first: close may change errno.
+         close(fd);
+         throw std::system_error(error, std::generic_category(), what);
+      }
+   }
+
+   // CONSTRUCTOR and DESTRUCTOR
+   file_sequence::file_sequence(const char* path,
+                                size_type initial_capacity)
+      :fd(-1), base(NULL), mapped(0), head(NULL), data(NULL)
+   {
+      static_assert(sizeof(header) == 64, "header must be 64 bytes");
+      struct stat info;
+
+      fd = open(path, O_RDWR | O_CREAT, 0644);
+      if (fd < 0)
+         fail("file_sequence: open");
+      if (fstat(fd, &info) != 0)
+         close_and_fail(fd, "file_sequence: fstat");
+
+      if (info.st_size == 0)
+      {                       //New file: lay out an empty sequence.
+         if (initial_capacity == 0)
+            initial_capacity = 1;
+         std::size_t bytes;
+         try
+         {
+            bytes = bytes_for(initial_capacity);
+         }
+         catch (...)
+         {
+            close(fd);
+            throw;
+         }
+         if (ftruncate(fd, bytes) != 0)
+            close_and_fail(fd, "file_sequence: ftruncate");
+         map(bytes);
+         std::memcpy(head->magic, MAGIC, sizeof(MAGIC));
+         head->used = 0;
+         head->capacity = initial_capacity;
+         head->current_index = 0;
+         return;
+      }
+
+      map(info.st_size);      //Existing file: just check the header.
+      if (mapped < sizeof(header)
+          || std::memcmp(head->magic, MAGIC, sizeof(MAGIC)) != 0
+          || head->capacity == 0
+          || head->capacity > (mapped - sizeof(header)) / sizeof(value_type)
+          || head->used > head->capacity
+          || head->current_index > head->used)
+      {
+         munmap(base, mapped);
+         close(fd);
+         throw std::runtime_error("file_sequence: not a sequence file");
+      }
+   }
+
+   file_sequence::~file_sequence()
+   {
+      munmap(base, mapped);
+      close(fd);
+   }
+
+   // MODIFICATION MEMBER FUNCTIONS
+   void file_sequence::resize(size_type new_capacity)
+   {
+      if (new_capacity < head->used)
+         new_capacity = head->used;//Keeps existing data.
+      if (new_capacity == 0)
+         new_capacity = 1;
+      if (new_capacity == head->capacity)
+         return;
+
+      //The order keeps head->capacity within the file at every step, so
+      //a crash or an error part way leaves a file that still opens (at
+      //worst longer than it needs to be): the file is grown before the
+      //capacity is raised, and the capacity is lowered before the file
+      //is shrunk.
+      std::size_t bytes = bytes_for(new_capacity);
+      size_type old_capacity = head->capacity;
+      if (new_capacity > old_capacity)
+      {
+         if (ftruncate(fd, bytes) != 0)
+            fail("file_sequence: ftruncate");
+         remap(bytes);
+         head->capacity = new_capacity;
+      }
+      else
+      {
+         head->capacity = new_capacity;
+         try
+         {
+            remap(bytes);
+         }
+         catch (...)
+         {
+            head->capacity = old_capacity;//Still mapped: nothing lost.
+            throw;
+         }
+         if (ftruncate(fd, bytes) != 0)
+            fail("file_sequence: ftruncate");
+      }
+   }
+
+   void file_sequence::start()
+   {
+      head->current_index = 0;
+   }
+
+   void file_sequence::advance()
+   {
+      if (is_item())
+         ++head->current_index;
+   }
+
+   void file_sequence::insert(const value_type& entry)
+   {
+      value_type hold = entry;//entry may be an item in the mapping.
+
+      if (head->used == head->capacity)
+         resize(2 * head->capacity);
+      if (!is_item())
+         head->current_index = 0;//No current item: insert at front.
+
+      std::size_t at = head->current_index;
+      std::memmove(data + at + 1, data + at,
+                   (head->used - at) * sizeof(value_type));
+      data[at] = hold;
+      ++head->used;
+   }
+
+   void file_sequence::attach(const value_type& entry)
+   {
+      value_type hold = entry;
+
+      if (head->used == head->capacity)
+         resize(2 * head->capacity);
+
+      std::size_t at = is_item() ? head->current_index + 1 : head->used;
+      std::memmove(data + at + 1, data + at,
+                   (head->used - at) * sizeof(value_type));
+      data[at] = hold;
+      ++head->used;
+      head->current_index = at;
+   }
+
+   void file_sequence::remove_current()
+   {
+      if (!is_item())
+         return;
+
+      std::size_t at = head->current_index;
+      std::memmove(data + at, data + at + 1,
+                   (head->used - at - 1) * sizeof(value_type));
+      --head->used;
+   }
+
+   void file_sequence::sync()
+   {
+      if (msync(base, mapped, MS_SYNC) != 0)
+         fail("file_sequence: msync");
+   }
+
+   void file_sequence::map(std::size_t bytes)
+   {
+      base = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      if (base == MAP_FAILED)
+      {
+         base = NULL;
+         close_and_fail(fd, "file_sequence: mmap");
+      }
+      mapped = bytes;
+      head = static_cast<header*>(base);
+      data = reinterpret_cast<value_type*>(head + 1);
+   }
+
+   void file_sequence::remap(std::size_t bytes)
+   {
+      void* moved;
+#ifdef MREMAP_MAYMOVE
+      moved = mremap(base, mapped, bytes, MREMAP_MAYMOVE);
+      if (moved == MAP_FAILED)
+         fail("file_sequence: mremap");
+#else
+      moved = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      if (moved == MAP_FAILED)
+         fail("file_sequence: mmap");
+      munmap(base, mapped);
+#endif
+      base = moved;
+      mapped = bytes;
+      head = static_cast<header*>(base);
+      data = reinterpret_cast<value_type*>(head + 1);
+   }
+
+   std::size_t file_sequence::bytes_for(size_type capacity)
+   {
+      //The bound is checked before multiplying, so that a huge capacity
+      //cannot wrap around to a small file.
+      if (capacity > (SIZE_MAX - sizeof(header)) / sizeof(value_type))
+         throw std::length_error("file_sequence: capacity too large");
+      return sizeof(header) + capacity * sizeof(value_type);
+   }
+
+   // CONSTANT MEMBER FUNCTIONS
+   file_sequence::size_type file_sequence::size() const
+   {
+      return head->used;
+   }
+
+   file_sequence::size_type file_sequence::capacity() const
+   {
+      return head->capacity;
+   }
+
+   bool file_sequence::is_item() const
+   {
+      return head->current_index < head->used;
+   }
+
+   file_sequence::value_type file_sequence::current() const
+   {
+      assert(is_item());
+      return data[head->current_index];
+   }
+}
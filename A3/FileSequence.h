@@ -0,0 +1,132 @@
+// FILE: FileSequence.h
+// CLASS PROVIDED: file_sequence (part of the namespace CS3358_Sp2016)
+//   A sequence of doubles whose items live in a memory-mapped file, so
+//   they survive the end of the program. It has the same cursor
+//   interface as sequence (see Sequence.h).
+//
+// FILE FORMAT:
+//   A 64-byte header (magic "SEQDBL01", then the number of items, the
+//   capacity and the cursor position as 64-bit unsigned integers)
+//   followed by capacity doubles. (A file may be longer than that if a
+//   resize was interrupted, by a crash or an error; the extra bytes are
+//   ignored, so no items are lost.) Integers and doubles are stored in
+//   the machine's own byte order, so a file is only portable between
+//   machines with the same byte order. Because the header and items are
+//   mapped directly, opening an existing file is O(1): nothing is read,
+//   parsed or copied.
+//
+// TYPEDEFS and MEMBER CONSTANTS for the file_sequence class:
+//   typedef double value_type
+//   typedef std::size_t size_type
+//     As for sequence.
+//
+//   static const size_type DEFAULT_CAPACITY = _____
+//     file_sequence::DEFAULT_CAPACITY is the capacity given to a new file
+//     by the constructor's default argument.
+//
+// CONSTRUCTOR and DESTRUCTOR for the file_sequence class:
+//   file_sequence(const char* path,
+//                 size_type initial_capacity = DEFAULT_CAPACITY)
+//    Pre:  path names a file that is either absent or was created by a
+//      file_sequence.
+//    Post: If the file exists, it has been mapped and the sequence holds
+//      its items, with the cursor where it was left. Otherwise the file
+//      has been created as an empty sequence with room for
+//      initial_capacity (at least 1) items.
+//    Note: Throws std::system_error if the file cannot be opened,
+//      created or mapped, std::runtime_error if an existing file is not
+//      in the format above, and std::length_error if initial_capacity
+//      items would not fit in a size_t number of bytes.
+//
+//   ~file_sequence()
+//    Post: The file has been unmapped and closed. Changes are left to
+//      the operating system to write back; call sync() first if they
+//      must be on disk when the destructor returns.
+//
+// MODIFICATION MEMBER FUNCTIONS for the file_sequence class:
+//   void resize(size_type new_capacity)
+//    Post: As for sequence::resize. The file is grown (or shrunk) with
+//      ftruncate and remapped with mremap where available, so the items
+//      are not copied by this program. Throws std::length_error (and
+//      changes nothing) if new_capacity items would not fit in a size_t
+//      number of bytes.
+//
+//   void start(), void advance(), void insert(const value_type& entry),
+//   void attach(const value_type& entry), void remove_current()
+//    As for sequence. insert and attach double the capacity when it
+//    has been reached.
+//
+//   void sync()
+//    Post: All changes have been written to the file (msync MS_SYNC).
+//
+// CONSTANT MEMBER FUNCTIONS for the file_sequence class:
+//   size_type size() const, bool is_item() const,
+//   value_type current() const
+//    As for sequence.
+//
+//   size_type capacity() const
+//    Post: The return value is the number of items the file has room
+//      for before it must be grown.
+//
+// VALUE SEMANTICS for the file_sequence class:
+//   A file_sequence owns its mapping, so it may not be copied or
+//   assigned. Two file_sequence objects must not open the same file at
+//   the same time.
+
+#ifndef FILESEQUENCE_H
+#define FILESEQUENCE_H
+#include <cstdlib>  // provides size_t
+#include <cstdint>  // provides uint64_t
+
+namespace CS3358_Sp2016
+{
+   class file_sequence
+   {
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef double value_type;
+      typedef std::size_t size_type;
+      static const size_type DEFAULT_CAPACITY = 1024;
+      // CONSTRUCTOR and DESTRUCTOR
+      explicit file_sequence(const char* path,
+                             size_type initial_capacity = DEFAULT_CAPACITY);
+      ~file_sequence();
+      // MODIFICATION MEMBER FUNCTIONS
+      void resize(size_type new_capacity);
+      void start();
+      void advance();
+      void insert(const value_type& entry);
+      void attach(const value_type& entry);
+      void remove_current();
+      void sync();
+      // CONSTANT MEMBER FUNCTIONS
+      size_type size() const;
+      size_type capacity() const;
+      bool is_item() const;
+      value_type current() const;
+   private:
+      struct header
+      {
+         char magic[8];
+         std::uint64_t used;
+         std::uint64_t capacity;
+         std::uint64_t current_index;
+         char unused[32];  // pads the header to 64 bytes
+      };
+
+      file_sequence(const file_sequence&) = delete;
+      file_sequence& operator=(const file_sequence&) = delete;
+      // HELPER MEMBER FUNCTIONS
+      void map(std::size_t bytes);
+      void remap(std::size_t bytes);
+      static std::size_t bytes_for(size_type capacity);
+
+      int fd;                // Descriptor of the open file
+      void* base;            // Start of the mapping
+      std::size_t mapped;    // Length of the mapping in bytes
+      header* head;          // Header at the start of the mapping
+      value_type* data;      // Items, just past the header
+   };
+}
+
+#endif
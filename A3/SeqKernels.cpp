@@ -0,0 +1,572 @@
+// FILE: SeqKernels.cpp
+// FUNCTIONS IMPLEMENTED: array reductions, searches, sorting, scans and
+//   rolling windows (see SeqKernels.h for documentation).
+// NOTE: Each public function picks its AVX2 version when the processor
+//   supports it and the scalar version otherwise. The AVX2 versions are
+//   compiled with the target("avx2") attribute, so the rest of the
+//   program does not need -mavx2.
+
+#include <algorithm>  // provides sort, merge, lower_bound, copy
+#include <cassert>
+#include <thread>     // provides thread, hardware_concurrency
+#include <vector>     // provides vector
+#include "SeqKernels.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SEQ_KERNELS_AVX2 1
+#define SEQ_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace CS3358_Sp2016
+{
+   namespace
+   {
+      // SCALAR VERSIONS
+      double sum_plain_scalar(const double* data, std::size_t n)
+      {
+         double total = 0.0;
+         for (std::size_t i = 0; i < n; ++i)
+            total += data[i];
+         return total;
+      }
+
+      void kahan_add(double& total, double& carry, double x)
+      {
+         double y = x - carry;
+         double t = total + y;
+         carry = (t - total) - y;//Low-order bits lost from y.
+         total = t;
+      }
+
+      double sum_kahan_scalar(const double* data, std::size_t n)
+      {
+         double total = 0.0, carry = 0.0;
+         for (std::size_t i = 0; i < n; ++i)
+            kahan_add(total, carry, data[i]);
+         return total;
+      }
+
+      double min_scalar(const double* data, std::size_t n)
+      {
+         double answer = data[0];
+         for (std::size_t i = 1; i < n; ++i)
+            if (data[i] < answer)
+               answer = data[i];
+         return answer;
+      }
+
+      double max_scalar(const double* data, std::size_t n)
+      {
+         double answer = data[0];
+         for (std::size_t i = 1; i < n; ++i)
+            if (data[i] > answer)
+               answer = data[i];
+         return answer;
+      }
+
+      std::size_t find_equal_scalar(const double* data, std::size_t n,
+                                    double target)
+      {
+         std::size_t i;
+         for (i = 0; i < n && data[i] != target; ++i)
+            ;//No work in the body of this loop.
+         return i;
+      }
+
+      std::size_t find_greater_scalar(const double* data, std::size_t n,
+                                      double threshold)
+      {
+         std::size_t i;
+         for (i = 0; i < n && !(data[i] > threshold); ++i)
+            ;//No work in the body of this loop.
+         return i;
+      }
+
+      void scan_scalar(const double* in, double* out, std::size_t n,
+                       double carry, bool inclusive)
+      {
+         for (std::size_t i = 0; i < n; ++i)
+         {
+            double x = in[i];//Read first: in and out may be the same.
+            if (inclusive)
+            {
+               carry += x;
+               out[i] = carry;
+            }
+            else
+            {
+               out[i] = carry;
+               carry += x;
+            }
+         }
+      }
+
+#ifdef SEQ_KERNELS_AVX2
+      // AVX2 VERSIONS
+      bool use_avx2()
+      {
+         static const bool supported = __builtin_cpu_supports("avx2");
+         return supported;
+      }
+
+      SEQ_AVX2 double hsum(__m256d v)
+      {
+         __m128d lo = _mm256_castpd256_pd128(v);
+         __m128d hi = _mm256_extractf128_pd(v, 1);
+         lo = _mm_add_pd(lo, hi);
+         return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+      }
+
+      SEQ_AVX2 double sum_plain_avx2(const double* data, std::size_t n)
+      {
+         __m256d acc0 = _mm256_setzero_pd();
+         __m256d acc1 = _mm256_setzero_pd();
+         std::size_t i = 0;
+
+         for (; i + 8 <= n; i += 8)//Two accumulators hide add latency.
+         {
+            acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(data + i));
+            acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(data + i + 4));
+         }
+         for (; i + 4 <= n; i += 4)
+            acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(data + i));
+         return hsum(_mm256_add_pd(acc0, acc1))
+                + sum_plain_scalar(data + i, n - i);
+      }
+
+      SEQ_AVX2 double sum_kahan_avx2(const double* data, std::size_t n)
+      {
+         __m256d total = _mm256_setzero_pd();
+         __m256d carry = _mm256_setzero_pd();
+         double lane_total[4], lane_carry[4];
+         double answer = 0.0, answer_carry = 0.0;
+         std::size_t i = 0;
+
+         for (; i + 4 <= n; i += 4)
+         {
+            __m256d y = _mm256_sub_pd(_mm256_loadu_pd(data + i), carry);
+            __m256d t = _mm256_add_pd(total, y);
+            carry = _mm256_sub_pd(_mm256_sub_pd(t, total), y);
+            total = t;
+         }
+         _mm256_storeu_pd(lane_total, total);
+         _mm256_storeu_pd(lane_carry, carry);
+         for (int k = 0; k < 4; ++k)//Folds lanes in with compensation too.
+         {
+            kahan_add(answer, answer_carry, lane_total[k]);
+            kahan_add(answer, answer_carry, -lane_carry[k]);
+         }
+         for (; i < n; ++i)
+            kahan_add(answer, answer_carry, data[i]);
+         return answer;
+      }
+
+      SEQ_AVX2 double min_avx2(const double* data, std::size_t n)
+      {
+         double lanes[4];
+         double answer;
+         std::size_t i = 0;
+
+         if (n < 4)
+            return min_scalar(data, n);
+         __m256d best = _mm256_loadu_pd(data);
+         for (i = 4; i + 4 <= n; i += 4)
+            best = _mm256_min_pd(best, _mm256_loadu_pd(data + i));
+         _mm256_storeu_pd(lanes, best);
+         answer = min_scalar(lanes, 4);
+         for (; i < n; ++i)
+            if (data[i] < answer)
+               answer = data[i];
+         return answer;
+      }
+
+      SEQ_AVX2 double max_avx2(const double* data, std::size_t n)
+      {
+         double lanes[4];
+         double answer;
+         std::size_t i = 0;
+
+         if (n < 4)
+            return max_scalar(data, n);
+         __m256d best = _mm256_loadu_pd(data);
+         for (i = 4; i + 4 <= n; i += 4)
+            best = _mm256_max_pd(best, _mm256_loadu_pd(data + i));
+         _mm256_storeu_pd(lanes, best);
+         answer = max_scalar(lanes, 4);
+         for (; i < n; ++i)
+            if (data[i] > answer)
+               answer = data[i];
+         return answer;
+      }
+
+      SEQ_AVX2 std::size_t find_equal_avx2(const double* data, std::size_t n,
+                                          double target)
+      {
+         __m256d t = _mm256_set1_pd(target);
+         std::size_t i = 0;
+
+         for (; i + 4 <= n; i += 4)
+         {
+            int mask = _mm256_movemask_pd(
+               _mm256_cmp_pd(_mm256_loadu_pd(data + i), t, _CMP_EQ_OQ));
+            if (mask != 0)
+               return i + __builtin_ctz(mask);
+         }
+         return i + find_equal_scalar(data + i, n - i, target);
+      }
+
+      SEQ_AVX2 std::size_t find_greater_avx2(const double* data,
+                                            std::size_t n, double threshold)
+      {
+         __m256d t = _mm256_set1_pd(threshold);
+         std::size_t i = 0;
+
+         for (; i + 4 <= n; i += 4)
+         {
+            int mask = _mm256_movemask_pd(
+               _mm256_cmp_pd(_mm256_loadu_pd(data + i), t, _CMP_GT_OQ));
+            if (mask != 0)
+               return i + __builtin_ctz(mask);
+         }
+         return i + find_greater_scalar(data + i, n - i, threshold);
+      }
+
+      SEQ_AVX2 void scan_avx2(const double* in, double* out, std::size_t n,
+                              double carry, bool inclusive)
+      {
+         //Each group of four is scanned in-register by two shift-and-add
+         //steps, then offset by the running total broadcast in c.
+         const __m256d zero = _mm256_setzero_pd();
+         __m256d c = _mm256_set1_pd(carry);
+         std::size_t i = 0;
+
+         for (; i + 4 <= n; i += 4)
+         {
+            __m256d x = _mm256_loadu_pd(in + i);
+            __m256d t = _mm256_add_pd(x, _mm256_blend_pd(
+               _mm256_permute4x64_pd(x, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0x1));
+            t = _mm256_add_pd(t, _mm256_blend_pd(
+               _mm256_permute4x64_pd(t, _MM_SHUFFLE(1, 0, 0, 0)), zero, 0x3));
+            __m256d total = _mm256_add_pd(c, t);
+            if (inclusive)
+               _mm256_storeu_pd(out + i, total);
+            else
+               _mm256_storeu_pd(out + i, _mm256_add_pd(c, _mm256_blend_pd(
+                  _mm256_permute4x64_pd(t, _MM_SHUFFLE(2, 1, 0, 0)),
+                  zero, 0x1)));
+            c = _mm256_permute4x64_pd(total, _MM_SHUFFLE(3, 3, 3, 3));
+         }
+         scan_scalar(in + i, out + i, n - i,
+                     _mm_cvtsd_f64(_mm256_castpd256_pd128(c)), inclusive);
+      }
+#endif
+
+      // DISPATCHERS
+      double sum_plain(const double* data, std::size_t n)
+      {
+#ifdef SEQ_KERNELS_AVX2
+         if (use_avx2())
+            return sum_plain_avx2(data, n);
+#endif
+         return sum_plain_scalar(data, n);
+      }
+
+      double sum_kahan(const double* data, std::size_t n)
+      {
+#ifdef SEQ_KERNELS_AVX2
+         if (use_avx2())
+            return sum_kahan_avx2(data, n);
+#endif
+         return sum_kahan_scalar(data, n);
+      }
+
+      double sum_pairwise(const double* data, std::size_t n)
+      {
+         if (n <= PAIRWISE_BLOCK)
+            return sum_plain(data, n);
+         return sum_pairwise(data, n / 2)
+                + sum_pairwise(data + n / 2, n - n / 2);
+      }
+
+      void scan_block(const double* in, double* out, std::size_t n,
+                      double carry, bool inclusive)
+      {
+#ifdef SEQ_KERNELS_AVX2
+         if (use_avx2())
+         {
+            scan_avx2(in, out, n, carry, inclusive);
+            return;
+         }
+#endif
+         scan_scalar(in, out, n, carry, inclusive);
+      }
+
+      // BLOCKED PARALLEL LOOPS
+      template <class Work>
+      void run_blocks(std::size_t blocks, std::size_t n, Work work)
+      {
+         //Calls work(first, last) on disjoint ranges of block numbers
+         //covering [0, blocks), each range on its own thread.
+         unsigned threads = 1;
+         if (n >= PARALLEL_SCAN_MIN)
+            threads = std::thread::hardware_concurrency();
+         if (threads > blocks)
+            threads = unsigned(blocks);
+         if (threads < 2)
+         {
+            work(std::size_t(0), blocks);
+            return;
+         }
+         std::vector<std::thread> pool;
+         for (unsigned t = 1; t < threads; ++t)
+            pool.push_back(std::thread(work, blocks * t / threads,
+                                       blocks * (t + 1) / threads));
+         work(std::size_t(0), blocks / threads);
+         for (std::size_t t = 0; t < pool.size(); ++t)
+            pool[t].join();
+      }
+
+      void scan(const double* in, double* out, std::size_t n, double init,
+                bool inclusive)
+      {
+         std::size_t blocks = (n + SCAN_BLOCK - 1) / SCAN_BLOCK;
+         if (blocks <= 1)
+         {
+            scan_block(in, out, n, init, inclusive);
+            return;
+         }
+
+         //Pass 1: each block's total. Then, serially, the total of all
+         //blocks before each one. Pass 2: scan each block from there.
+         std::vector<double> offset(blocks);
+         run_blocks(blocks, n, [&](std::size_t first, std::size_t last)
+         {
+            for (std::size_t b = first; b < last; ++b)
+               offset[b] = sum_plain(in + b * SCAN_BLOCK,
+                                     std::min(SCAN_BLOCK, n - b * SCAN_BLOCK));
+         });
+         double carry = init;
+         for (std::size_t b = 0; b < blocks; ++b)
+         {
+            double block_total = offset[b];
+            offset[b] = carry;
+            carry += block_total;
+         }
+         run_blocks(blocks, n, [&](std::size_t first, std::size_t last)
+         {
+            for (std::size_t b = first; b < last; ++b)
+               scan_block(in + b * SCAN_BLOCK, out + b * SCAN_BLOCK,
+                          std::min(SCAN_BLOCK, n - b * SCAN_BLOCK),
+                          offset[b], inclusive);
+         });
+      }
+
+      template <class Combine>
+      void window_segments(const double* in, double* out, std::size_t n,
+                           std::size_t k, std::size_t first,
+                           std::size_t last, Combine combine)
+      {
+         //van Herk / Gil-Werman: the array is cut into segments of k
+         //items. The window starting at o is the rest of o's segment (a
+         //suffix, built backward) and then the start of the next segment
+         //up to o + k - 1 (a prefix, built forward), so each output
+         //combines just two partial results, whatever k is. This fills
+         //the outputs of segments first..last-1.
+         std::size_t outputs = n - k + 1;
+         for (std::size_t g = first; g < last; ++g)
+         {
+            std::size_t base = g * k;
+            std::size_t end = std::min(base + k, n);
+            std::size_t stop = std::min(base + k, outputs);
+
+            double part = in[end - 1];
+            if (end - 1 < stop)
+               out[end - 1] = part;
+            for (std::size_t i = end - 1; i > base; )
+            {
+               --i;
+               part = combine(in[i], part);
+               if (i < stop)
+                  out[i] = part;
+            }
+
+            if (base + 1 < stop)
+               part = in[base + k];
+            for (std::size_t o = base + 1; o < stop; ++o)
+            {
+               if (o > base + 1)
+                  part = combine(part, in[o + k - 1]);
+               out[o] = combine(out[o], part);
+            }
+         }
+      }
+
+      // PARALLEL SORT
+      void parallel_merge(const double* a, std::size_t na,
+                          const double* b, std::size_t nb,
+                          double* out, unsigned threads)
+      {
+         //Splits at the middle of the longer run and the matching point
+         //of the shorter one, so both halves can be merged at once.
+         if (threads < 2 || na + nb < PARALLEL_SORT_MIN)
+         {
+            std::merge(a, a + na, b, b + nb, out);
+            return;
+         }
+         if (na < nb)
+         {
+            parallel_merge(b, nb, a, na, out, threads);
+            return;
+         }
+         std::size_t ma = na / 2;
+         std::size_t mb = std::lower_bound(b, b + nb, a[ma]) - b;
+         std::thread left(parallel_merge, a, ma, b, mb, out, threads / 2);
+         parallel_merge(a + ma, na - ma, b + mb, nb - mb, out + ma + mb,
+                        threads - threads / 2);
+         left.join();
+      }
+
+      void parallel_sort(double* data, double* buffer, std::size_t n,
+                         unsigned threads)
+      {
+         if (threads < 2 || n < PARALLEL_SORT_MIN)
+         {
+            std::sort(data, data + n);
+            return;
+         }
+         std::size_t half = n / 2;
+         std::thread left(parallel_sort, data, buffer, half, threads / 2);
+         parallel_sort(data + half, buffer + half, n - half,
+                       threads - threads / 2);
+         left.join();
+         parallel_merge(data, half, data + half, n - half, buffer, threads);
+         std::copy(buffer, buffer + n, data);
+      }
+   }
+
+   double seq_sum(const double* data, std::size_t n, sum_mode mode)
+   {
+      switch (mode)
+      {
+         case SUM_KAHAN:
+            return sum_kahan(data, n);
+         case SUM_PAIRWISE:
+            return sum_pairwise(data, n);
+         default:
+            return sum_plain(data, n);
+      }
+   }
+
+   double seq_min(const double* data, std::size_t n)
+   {
+      assert(n > 0);
+#ifdef SEQ_KERNELS_AVX2
+      if (use_avx2())
+         return min_avx2(data, n);
+#endif
+      return min_scalar(data, n);
+   }
+
+   double seq_max(const double* data, std::size_t n)
+   {
+      assert(n > 0);
+#ifdef SEQ_KERNELS_AVX2
+      if (use_avx2())
+         return max_avx2(data, n);
+#endif
+      return max_scalar(data, n);
+   }
+
+   std::size_t seq_argmin(const double* data, std::size_t n)
+   {
+      //Two passes (find the value, then its first index) keep both
+      //passes branch-free in the vector loop.
+      return seq_find(data, n, seq_min(data, n));
+   }
+
+   std::size_t seq_argmax(const double* data, std::size_t n)
+   {
+      return seq_find(data, n, seq_max(data, n));
+   }
+
+   std::size_t seq_find_first_greater(const double* data, std::size_t n,
+                                      double threshold)
+   {
+#ifdef SEQ_KERNELS_AVX2
+      if (use_avx2())
+         return find_greater_avx2(data, n, threshold);
+#endif
+      return find_greater_scalar(data, n, threshold);
+   }
+
+   std::size_t seq_find(const double* data, std::size_t n, double target)
+   {
+#ifdef SEQ_KERNELS_AVX2
+      if (use_avx2())
+         return find_equal_avx2(data, n, target);
+#endif
+      return find_equal_scalar(data, n, target);
+   }
+
+   void seq_sort(double* data, std::size_t n)
+   {
+      unsigned threads = std::thread::hardware_concurrency();
+
+      if (threads < 2 || n < PARALLEL_SORT_MIN)
+      {
+         std::sort(data, data + n);
+         return;
+      }
+      std::vector<double> buffer(n);
+      parallel_sort(data, &buffer[0], n, threads);
+   }
+
+   void seq_inclusive_scan(const double* in, double* out, std::size_t n)
+   {
+      scan(in, out, n, 0.0, true);
+   }
+
+   void seq_exclusive_scan(const double* in, double* out, std::size_t n,
+                           double init)
+   {
+      scan(in, out, n, init, false);
+   }
+
+   void seq_rolling_window(const double* in, double* out, std::size_t n,
+                           std::size_t k, window_op op)
+   {
+      assert(1 <= k && k <= n);
+      std::size_t outputs = n - k + 1;
+      std::size_t segments = (outputs + k - 1) / k;
+      std::size_t per_block = std::max(std::size_t(1), SCAN_BLOCK / k);
+      std::size_t blocks = (segments + per_block - 1) / per_block;
+
+      //Each block is a whole number of segments, about SCAN_BLOCK items.
+      run_blocks(blocks, n, [&](std::size_t first, std::size_t last)
+      {
+         std::size_t from = first * per_block;
+         std::size_t to = std::min(segments, last * per_block);
+         switch (op)
+         {
+            case WINDOW_MIN:
+               window_segments(in, out, n, k, from, to,
+                               [](double x, double y)
+                               { return (y < x) ? y : x; });
+               break;
+            case WINDOW_MAX:
+               window_segments(in, out, n, k, from, to,
+                               [](double x, double y)
+                               { return (y > x) ? y : x; });
+               break;
+            default:
+               window_segments(in, out, n, k, from, to,
+                               [](double x, double y) { return x + y; });
+               if (op == WINDOW_MEAN)
+                  for (std::size_t o = from * k;
+                       o < std::min(outputs, to * k); ++o)
+                     out[o] /= k;
+         }
+      });
+   }
+}
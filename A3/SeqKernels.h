@@ -0,0 +1,129 @@
+// FILE: SeqKernels.h
+// FUNCTIONS PROVIDED: reductions, searches, sorting, scans and rolling
+//   windows over a contiguous array of double (part of the namespace
+//   CS3358_Sp2016). The sequence class uses these on its data buffer;
+//   they may also be used on any double array.
+//
+// NOTE: On x86 processors that support AVX2 (checked once at run time),
+//   each reduction and search processes four doubles per instruction.
+//   Elsewhere a scalar loop is used. The AVX2 sum adds in a different
+//   order than the scalar loop, so SUM_PLAIN results may differ in the
+//   last bits between the two paths.
+//
+// ENUM for the kernels:
+//   enum sum_mode { SUM_PLAIN, SUM_KAHAN, SUM_PAIRWISE }
+//    SUM_PLAIN    straight (lane-wise) accumulation; fastest.
+//    SUM_KAHAN    compensated (Kahan) summation in each lane; the error
+//      does not grow with n.
+//    SUM_PAIRWISE recursive halving down to blocks of PAIRWISE_BLOCK
+//      items; the error grows with log(n).
+//
+//   enum window_op { WINDOW_SUM, WINDOW_MEAN, WINDOW_MIN, WINDOW_MAX }
+//    The aggregate computed over each window by seq_rolling_window.
+//
+// FUNCTIONS:
+//   double seq_sum(const double* data, std::size_t n,
+//                  sum_mode mode = SUM_PLAIN)
+//    Pre:  data points to at least n doubles.
+//    Post: The return value is the sum of data[0..n-1] (0.0 if n == 0).
+//
+//   double seq_min(const double* data, std::size_t n)
+//   double seq_max(const double* data, std::size_t n)
+//    Pre:  n > 0 and no item is NaN.
+//    Post: The return value is the smallest (largest) of data[0..n-1].
+//
+//   std::size_t seq_argmin(const double* data, std::size_t n)
+//   std::size_t seq_argmax(const double* data, std::size_t n)
+//    Pre:  n > 0 and no item is NaN.
+//    Post: The return value is the index of the first occurrence of the
+//      smallest (largest) of data[0..n-1].
+//
+//   std::size_t seq_find_first_greater(const double* data, std::size_t n,
+//                                      double threshold)
+//    Pre:  data points to at least n doubles.
+//    Post: The return value is the smallest index i with
+//      data[i] > threshold, or n if there is no such index.
+//
+//   std::size_t seq_find(const double* data, std::size_t n, double target)
+//    Pre:  data points to at least n doubles.
+//    Post: The return value is the smallest index i with
+//      data[i] == target, or n if there is no such index.
+//
+//   void seq_sort(double* data, std::size_t n)
+//    Pre:  data points to at least n doubles, none of which is NaN.
+//    Post: data[0..n-1] is in ascending order. When n is at least
+//      PARALLEL_SORT_MIN and more than one hardware thread is available,
+//      this is a merge sort whose halves are sorted and merged on
+//      separate threads (one per hardware thread at most); otherwise it
+//      is std::sort.
+//
+// SCANS and ROLLING WINDOWS:
+//   These split the array into fixed blocks (of SCAN_BLOCK items for the
+//   scans, and of whole window segments, described below, for the
+//   windows) and, when n is at least PARALLEL_SCAN_MIN, spread the blocks
+//   over the hardware threads. Scans take two passes: the block totals, then a
+//   scan of each block starting from the sum of the blocks before it
+//   (AVX2 within a block where available). Because the blocks, and the
+//   order of the additions in each, do not depend on the number of
+//   threads, the results on a given machine are the same bit for bit
+//   whatever the thread count; when all partial sums are exact (e.g.
+//   integer values below 2^53) they are the same on every machine.
+//   For the scans, in and out may be the same array.
+//
+//   void seq_inclusive_scan(const double* in, double* out, std::size_t n)
+//    Pre:  in and out point to at least n doubles.
+//    Post: out[i] is in[0] + ... + in[i], for i < n.
+//
+//   void seq_exclusive_scan(const double* in, double* out, std::size_t n,
+//                           double init = 0.0)
+//    Pre:  in and out point to at least n doubles.
+//    Post: out[i] is init + in[0] + ... + in[i-1], for i < n (so
+//      out[0] is init).
+//
+//   void seq_rolling_window(const double* in, double* out, std::size_t n,
+//                           std::size_t k, window_op op)
+//    Pre:  1 <= k <= n; in points to n doubles and out to n - k + 1;
+//      for WINDOW_MIN and WINDOW_MAX no item is NaN. in and out must
+//      not overlap.
+//    Post: out[i] is op applied to in[i..i+k-1], for i <= n - k. This
+//      uses the van Herk / Gil-Werman method: the array is cut into
+//      segments of k items, each window is the end of one segment and
+//      the start of the next, and out[i] combines the suffix of the
+//      first (built backward) with the prefix of the second (built
+//      forward). So all four ops take O(n) time whatever k is, and a
+//      sum is the total of two partial sums of at most k items each:
+//      nothing is subtracted, and rounding error does not build up
+//      across the array.
+
+#ifndef SEQKERNELS_H
+#define SEQKERNELS_H
+#include <cstdlib>  // provides size_t
+
+namespace CS3358_Sp2016
+{
+   enum sum_mode { SUM_PLAIN, SUM_KAHAN, SUM_PAIRWISE };
+   enum window_op { WINDOW_SUM, WINDOW_MEAN, WINDOW_MIN, WINDOW_MAX };
+
+   const std::size_t PAIRWISE_BLOCK = 128;
+   const std::size_t PARALLEL_SORT_MIN = 1 << 16;
+   const std::size_t SCAN_BLOCK = 1 << 14;
+   const std::size_t PARALLEL_SCAN_MIN = 1 << 17;
+
+   double seq_sum(const double* data, std::size_t n,
+                  sum_mode mode = SUM_PLAIN);
+   double seq_min(const double* data, std::size_t n);
+   double seq_max(const double* data, std::size_t n);
+   std::size_t seq_argmin(const double* data, std::size_t n);
+   std::size_t seq_argmax(const double* data, std::size_t n);
+   std::size_t seq_find_first_greater(const double* data, std::size_t n,
+                                      double threshold);
+   std::size_t seq_find(const double* data, std::size_t n, double target);
+   void seq_sort(double* data, std::size_t n);
+   void seq_inclusive_scan(const double* in, double* out, std::size_t n);
+   void seq_exclusive_scan(const double* in, double* out, std::size_t n,
+                           double init = 0.0);
+   void seq_rolling_window(const double* in, double* out, std::size_t n,
+                           std::size_t k, window_op op);
+}
+
+#endif
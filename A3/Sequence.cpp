@@ -37,8 +37,23 @@
 //                postcondition for the function for both of the two
 //                possible scenarios (current item is and is not the
 //                last item in the sequence).
+//   5. The dynamic array may be shared by several sequences (after a
+//      copy or assignment). The member variable refs points to the
+//      number of sequences sharing it; the count is atomic so that
+//      copies may live on different threads. Every member function that
+//      changes the items calls unshare() first, which gives this
+//      sequence a private copy of the array if refs is above one, so
+//      that a change is never seen through another sequence.
+//   6. The member variable sorted is true when the sequence is in sorted
+//      mode, in which case data[0] through data[used-1] are kept in
+//      ascending order.
 
+#include <algorithm>  // provides upper_bound, lower_bound, min, max
 #include <cassert>
+#include <charconv>   // provides from_chars, to_chars
+#include <cstdint>    // provides uint64_t
+#include <cstring>    // provides memcpy
+#include <vector>     // provides vector
 #include "Sequence.h"
 #include <iostream>
 using namespace std;
@@ -47,7 +62,7 @@ namespace CS3358_Sp2016
 {
    // CONSTRUCTORS and DESTRUCTOR
    sequence::sequence(size_type initial_capacity)
-      :used(0), capacity(DEFAULT_CAPACITY)
+      :used(0), current_index(0), capacity(DEFAULT_CAPACITY), sorted(false)
    {
       if (initial_capacity > 0)
       {
@@ -57,22 +72,20 @@ namespace CS3358_Sp2016
          initial_capacity = 1;     //Initializes, assigns to default,
                                    //if negative number, sets to 1.
       data = new value_type[initial_capacity];//Creates array.
+      refs = new std::atomic<long>(1);
    }
 
    sequence::sequence(const sequence& source)
-      :used(source.used), current_index(source.current_index),
-       capacity(source.capacity)
+      :data(source.data), used(source.used),
+       current_index(source.current_index), capacity(source.capacity),
+       sorted(source.sorted), refs(source.refs)
    {
-      data = new value_type[capacity]; //Creates a new array obj,
-      for (size_type i = 0; i < used; i++)//Copies over all data 
-      {                                   //to new obj.
-         data[i] = source.data[i];
-      }
-   }
+      refs->fetch_add(1, std::memory_order_relaxed);//Shares the array;
+   }                                   //copied on first modification.
 
    sequence::~sequence()
    {
-      delete [] data;//Deletes array.
+      release();//Deletes array if this was its last user.
    }
 
    // MODIFICATION MEMBER FUNCTIONS
@@ -92,8 +105,9 @@ namespace CS3358_Sp2016
       {
          newData[j] = data[j];//Assigns data to new obj.
       }
-      delete [] data;//Deletes old data.
+      release();//Lets go of old data.
       data = newData;//Points to new obj.
+      refs = new std::atomic<long>(1);
    }
 
    void sequence::start()
@@ -122,7 +136,13 @@ namespace CS3358_Sp2016
    {
       if (size() == capacity)//Resizes if at max capacity.
          resize(size_type (1.25 * capacity) + 1);
+      unshare();
 
+      if (sorted)
+      {
+         insert_sorted(entry);//Cursor is ignored in sorted mode.
+         return;
+      }
       if (is_item() == false)//Returns to beginning if 
       {                      //there is no current item.
          current_index = 0;
@@ -139,7 +159,13 @@ namespace CS3358_Sp2016
    {
       if (size() == capacity)
          resize (size_type (1.25 * capacity) + 1);
+      unshare();
 
+      if (sorted)
+      {
+         insert_sorted(entry);
+         return;
+      }
       if (is_item() == false)
       {
          current_index = used - 1;
@@ -157,7 +183,8 @@ namespace CS3358_Sp2016
    {
       if (is_item() == true)
       {
-         for (size_type k = current_index; k < used; k++)
+         unshare();
+         for (size_type k = current_index; k + 1 < used; k++)
          {
             data[k] = data[k+1];//Shifts all elements to the left
          }                      //after removal.
@@ -165,24 +192,74 @@ namespace CS3358_Sp2016
       }
    }
 
+   void sequence::sort()
+   {
+      unshare();
+      seq_sort(data, used);
+   }
+
+   void sequence::set_sorted(bool on)
+   {
+      if (on && !sorted)
+         sort();
+      sorted = on;
+   }
+
+   void sequence::insert_sorted(const value_type& entry)
+   {
+      //Pre: used < capacity and data[0..used-1] is ascending.
+      size_type pos = std::upper_bound(data, data + used, entry) - data;
+      for (size_type j = used; j > pos; j--)
+      {
+         data[j] = data[j-1];//Shifts larger elements to the right.
+      }
+      data[pos] = entry;
+      current_index = pos;
+      used++;
+   }
+
    sequence& sequence::operator=(const sequence& source)
    {
+      if (data != source.data)
+      {
+         source.refs->fetch_add(1, std::memory_order_relaxed);
+         release();//Lets go of old data,
+         data = source.data;//then shares source's and assigns all
+         refs = source.refs;
+      }
       if (this != &source)
       {
-         value_type* newData = new value_type[source.capacity];
-         for (size_type j = 0; j < source.used; j++)
-         {
-            newData[j] = source.data[j];
-         }
-         delete [] data;//Deletes old data,
-         data = newData;//then assigns all
          used = source.used;//appropriate information.
          current_index = source.current_index;
          capacity = source.capacity;
+         sorted = source.sorted;
       }
       return *this;
    }
 
+   void sequence::unshare()
+   {
+      if (refs->load(std::memory_order_acquire) == 1)
+         return;//Sole owner already.
+      value_type* newData = new value_type[capacity];
+      for (size_type j = 0; j < used; j++)
+      {
+         newData[j] = data[j];
+      }
+      release();
+      data = newData;
+      refs = new std::atomic<long>(1);
+   }
+
+   void sequence::release()
+   {
+      if (refs->fetch_sub(1, std::memory_order_acq_rel) == 1)
+      {
+         delete [] data;//Last user deletes the array.
+         delete refs;
+      }
+   }
+
    // CONSTANT MEMBER FUNCTIONS
    sequence::size_type sequence::size() const
    {
@@ -209,4 +286,300 @@ namespace CS3358_Sp2016
       }
       return data[current_index];
    }
+
+   bool sequence::is_sorted_mode() const
+   {
+      return sorted;
+   }
+
+   sequence::size_type sequence::find(const value_type& target) const
+   {
+      if (sorted)
+      {
+         const value_type* pos = std::lower_bound(data, data + used, target);
+         if (pos != data + used && *pos == target)
+            return pos - data;
+         return used;
+      }
+      return seq_find(data, used, target);
+   }
+
+   // REDUCTIONS and SEARCHES
+   sequence::value_type sequence::sum(sum_mode mode) const
+   {
+      return seq_sum(data, used, mode);
+   }
+
+   sequence::value_type sequence::mean(sum_mode mode) const
+   {
+      assert(used > 0);
+      return seq_sum(data, used, mode) / used;
+   }
+
+   sequence::value_type sequence::min() const
+   {
+      assert(used > 0);
+      return seq_min(data, used);
+   }
+
+   sequence::value_type sequence::max() const
+   {
+      assert(used > 0);
+      return seq_max(data, used);
+   }
+
+   sequence::size_type sequence::argmin() const
+   {
+      assert(used > 0);
+      return seq_argmin(data, used);
+   }
+
+   sequence::size_type sequence::argmax() const
+   {
+      assert(used > 0);
+      return seq_argmax(data, used);
+   }
+
+   sequence::size_type sequence::find_first_greater
+      (const value_type& threshold) const
+   {
+      return seq_find_first_greater(data, used, threshold);
+   }
+
+   // SCANS and ROLLING WINDOWS
+   sequence sequence::inclusive_scan() const
+   {
+      sequence answer;
+
+      answer.resize(used);//Room for the results, written in place.
+      seq_inclusive_scan(data, answer.data, used);
+      answer.used = answer.current_index = used;
+      return answer;
+   }
+
+   sequence sequence::exclusive_scan(value_type init) const
+   {
+      sequence answer;
+
+      answer.resize(used);
+      seq_exclusive_scan(data, answer.data, used, init);
+      answer.used = answer.current_index = used;
+      return answer;
+   }
+
+   sequence sequence::rolling_window(size_type k, window_op op) const
+   {
+      assert(1 <= k && k <= used);
+      sequence answer;
+      size_type outputs = used - k + 1;
+
+      answer.resize(outputs);
+      seq_rolling_window(data, answer.data, used, k, op);
+      answer.used = answer.current_index = outputs;
+      return answer;
+   }
+
+   // BULK INPUT and OUTPUT
+   namespace
+   {
+      const size_t IO_BLOCK = 1 << 20;//Bytes per read or write call.
+
+      bool little_endian()
+      {
+         const std::uint16_t probe = 1;
+         unsigned char first;
+         std::memcpy(&first, &probe, 1);
+         return first == 1;
+      }
+
+      void swap_bytes(unsigned char* bytes, size_t width, size_t count)
+      {
+         for (size_t i = 0; i < count; i++, bytes += width)
+            std::reverse(bytes, bytes + width);
+      }
+
+      bool is_separator(char c)
+      {
+         return c == ',' || c == ' ' || c == '\n' || c == '\t'
+                || c == '\r' || c == '\f' || c == '\v';
+      }
+   }
+
+   sequence::size_type sequence::load_text(istream& in)
+   {
+      vector<char> buffer(IO_BLOCK);
+      size_t kept = 0;//Bytes of an unfinished token carried over.
+      size_type count = 0;
+      bool had_item = is_item();
+      bool more = true;
+
+      unshare();
+      while (more)
+      {
+         in.read(&buffer[kept], IO_BLOCK - kept);
+         size_t end = kept + size_t(in.gcount());
+         more = (in.gcount() > 0) && !in.eof();
+         const char* p = &buffer[0];
+         const char* last = p + end;
+         kept = 0;
+         while (p != last)
+         {
+            while (p != last && is_separator(*p))
+               p++;
+            const char* token = p;
+            while (p != last && !is_separator(*p))
+               p++;
+            if (token == p)
+               break;
+            if (p == last && more)
+            {                  //Token may continue in the next block.
+               kept = p - token;
+               if (kept == IO_BLOCK)
+               {
+                  in.setstate(ios::failbit);//No number is this long.
+                  finish_load(had_item);
+                  return count;
+               }
+               std::memmove(&buffer[0], token, kept);
+               break;
+            }
+            if (*token == '+')
+               token++;//from_chars does not accept a leading '+'.
+            value_type x;
+            from_chars_result r = from_chars(token, p, x);
+            if (r.ec != errc() || r.ptr != p)
+            {
+               in.clear(in.rdstate() & ~ios::eofbit);
+               in.setstate(ios::failbit);
+               finish_load(had_item);
+               return count;
+            }
+            append_raw(x);
+            count++;
+         }
+      }
+      if (in.eof())//Reaching end of file is not a failure.
+         in.clear(in.rdstate() & ~ios::failbit);
+      finish_load(had_item);
+      return count;
+   }
+
+   void sequence::save_text(ostream& out) const
+   {
+      vector<char> buffer(IO_BLOCK);
+      char* p = &buffer[0];
+      char* last = p + IO_BLOCK;
+      const size_t LONGEST = 32;//Longest shortest-form double, plus '\n'.
+
+      for (size_type j = 0; j < used; j++)
+      {
+         if (size_t(last - p) < LONGEST)
+         {
+            out.write(&buffer[0], p - &buffer[0]);
+            p = &buffer[0];
+         }
+         p = to_chars(p, last, data[j]).ptr;
+         *p++ = '\n';
+      }
+      out.write(&buffer[0], p - &buffer[0]);
+   }
+
+   sequence::size_type sequence::load(istream& in)
+   {
+      unsigned char header[8];
+      std::uint64_t many;
+      bool had_item = is_item();
+
+      if (!in.read(reinterpret_cast<char*>(header), sizeof(header)))
+         return 0;
+      if (!little_endian())
+         swap_bytes(header, sizeof(header), 1);
+      std::memcpy(&many, header, sizeof(header));
+
+      unshare();
+      size_type count = 0;
+      while (count < many)
+      {                       //Reads straight into data, a block at a time.
+         size_type want = size_type(many - count);
+         if (want > IO_BLOCK / sizeof(value_type))
+            want = IO_BLOCK / sizeof(value_type);
+         if (used + want > capacity)
+            resize(std::max(used + want, 2 * capacity));
+         in.read(reinterpret_cast<char*>(data + used),
+                 want * sizeof(value_type));
+         size_type got = size_type(in.gcount()) / sizeof(value_type);
+         if (!little_endian())
+            swap_bytes(reinterpret_cast<unsigned char*>(data + used),
+                       sizeof(value_type), got);
+         used += got;
+         count += got;
+         if (got < want)
+            break;//in has set failbit.
+      }
+      finish_load(had_item);
+      return count;
+   }
+
+   void sequence::save(ostream& out) const
+   {
+      std::uint64_t many = used;
+      unsigned char header[8];
+
+      std::memcpy(header, &many, sizeof(header));
+      if (little_endian())
+      {
+         out.write(reinterpret_cast<const char*>(header), sizeof(header));
+         out.write(reinterpret_cast<const char*>(data),
+                   used * sizeof(value_type));
+         return;
+      }
+      swap_bytes(header, sizeof(header), 1);
+      out.write(reinterpret_cast<const char*>(header), sizeof(header));
+      vector<value_type> block(IO_BLOCK / sizeof(value_type));
+      for (size_type j = 0; j < used; j += block.size())
+      {
+         size_type n = std::min(block.size(), used - j);
+         std::memcpy(&block[0], data + j, n * sizeof(value_type));
+         swap_bytes(reinterpret_cast<unsigned char*>(&block[0]),
+                    sizeof(value_type), n);
+         out.write(reinterpret_cast<const char*>(&block[0]),
+                   n * sizeof(value_type));
+      }
+   }
+
+   void sequence::append_raw(const value_type& entry)
+   {
+      //Pre: data is not shared. Adds entry at the end, ignoring the
+      //cursor and sorted mode (finish_load puts those right).
+      if (used == capacity)
+         resize(2 * capacity);
+      data[used++] = entry;
+   }
+
+   void sequence::finish_load(bool had_item)
+   {
+      if (sorted)
+      {
+         seq_sort(data, used);
+         current_index = used;
+      }
+      else if (!had_item)
+         current_index = used;
+   }
+
+   // VIEWS
+   sequence_view sequence::view() const
+   {
+      return sequence_view(data, used);
+   }
+
+   sequence_view sequence::view(size_type first, size_type count,
+                                size_type stride) const
+   {
+      assert(stride > 0);
+      if (count == 0)
+         return sequence_view();
+      assert(first + (count - 1) * stride < used);
+      return sequence_view(data + first, count, stride);
+   }
 }
@@ -70,6 +70,21 @@
 //      item. If the current item was already the last item in the
 //      sequence, then there is no longer any current item.
 //
+//   void sort()
+//    Pre:  No item is NaN.
+//    Post: The items are in ascending order. The current item (if any)
+//      is whichever item is now at the cursor's position. Sequences of
+//      PARALLEL_SORT_MIN or more items are sorted on several threads
+//      (see seq_sort in SeqKernels.h).
+//
+//   void set_sorted(bool on)
+//    Pre:  If on is true, no item is NaN.
+//    Post: If on is true, the sequence has been sorted and is in sorted
+//      mode: until set_sorted(false), insert and attach ignore the
+//      cursor and place the new item after any items equal to it,
+//      using binary search, and the new item becomes the current item.
+//      If on is false, insert and attach work as documented above.
+//
 // CONSTANT MEMBER FUNCTIONS for the sequence class:
 //   size_type size() const
 //    Pre:  none
@@ -86,13 +101,125 @@
 //    Pre:  is_item() returns true.
 //    Post: The item returned is the current item in the sequence.
 //
+//   bool is_sorted_mode() const
+//    Pre:  none
+//    Post: The return value is true if the sequence is in sorted mode.
+//
+//   size_type find(const value_type& target) const
+//    Pre:  none
+//    Post: The return value is the position of the first item equal to
+//      target (the first item is position 0), or size() if there is no
+//      such item. In sorted mode this is a binary search (O(log n));
+//      otherwise it is a linear scan. The cursor does not move.
+//
+// REDUCTIONS and SEARCHES for the sequence class (these scan the whole
+// sequence directly, without moving the cursor; positions are indexes
+// where the first item is 0; see SeqKernels.h for the sum modes):
+//   value_type sum(sum_mode mode = SUM_PLAIN) const
+//    Pre:  none
+//    Post: The return value is the sum of the items (0.0 if empty).
+//
+//   value_type mean(sum_mode mode = SUM_PLAIN) const
+//    Pre:  size() > 0
+//    Post: The return value is sum(mode) / size().
+//
+//   value_type min() const
+//   value_type max() const
+//    Pre:  size() > 0 and no item is NaN.
+//    Post: The return value is the smallest (largest) item.
+//
+//   size_type argmin() const
+//   size_type argmax() const
+//    Pre:  size() > 0 and no item is NaN.
+//    Post: The return value is the position of the first smallest
+//      (largest) item.
+//
+//   template <class Predicate> size_type count_if(Predicate pred) const
+//    Pre:  pred can be called with a value_type and returns bool.
+//    Post: The return value is the number of items for which pred
+//      returns true.
+//
+//   size_type find_first_greater(const value_type& threshold) const
+//    Pre:  none
+//    Post: The return value is the position of the first item greater
+//      than threshold, or size() if there is no such item.
+//
+// SCANS and ROLLING WINDOWS for the sequence class (each returns a new
+// sequence with no current item and leaves this one unchanged; see
+// SeqKernels.h for how the work is split over threads):
+//   sequence inclusive_scan() const
+//    Post: Item i of the returned sequence is the sum of items 0
+//      through i of this sequence (running totals).
+//
+//   sequence exclusive_scan(value_type init = 0.0) const
+//    Post: Item i of the returned sequence is init plus the sum of
+//      items 0 through i - 1 (so item 0 is init).
+//
+//   sequence rolling_window(size_type k, window_op op) const
+//    Pre:  1 <= k <= size(); for WINDOW_MIN and WINDOW_MAX no item is
+//      NaN.
+//    Post: The returned sequence has size() - k + 1 items; item i is
+//      the sum, mean, min or max (by op) of items i through i + k - 1.
+//
+// VIEWS of the sequence (see SequenceView.h; a view is invalidated by
+// any change to the sequence):
+//   sequence_view view() const
+//    Post: The return value views all the items, in order.
+//
+//   sequence_view view(size_type first, size_type count,
+//                      size_type stride = 1) const
+//    Pre:  stride > 0, and if count > 0,
+//      first + (count - 1) * stride < size().
+//    Post: The return value views the items at positions first,
+//      first + stride, ... (count of them). O(1); nothing is copied.
+//
+// BULK INPUT and OUTPUT for the sequence class (the load functions
+// append to the end of the sequence; the current item is unchanged, and
+// if there was none there still is none; in sorted mode the sequence is
+// re-sorted afterwards and there is no current item):
+//   size_type load_text(std::istream& in)
+//    Pre:  none
+//    Post: Numbers separated by whitespace and/or commas have been read
+//      from in until end of file and appended. The return value is how
+//      many were read. If a token is not a number, reading stops there
+//      and in's failbit is set; the numbers before it are kept. The
+//      text is read in large blocks and parsed with std::from_chars.
+//
+//   void save_text(std::ostream& out) const
+//    Pre:  none
+//    Post: The items have been written to out, one per line, in the
+//      shortest form that reads back to the same double
+//      (std::to_chars).
+//
+//   size_type load(std::istream& in)
+//    Pre:  in was opened in binary mode.
+//    Post: A binary sequence (as written by save) has been read from in
+//      and its items appended. The return value is how many were read.
+//      If in ends early, the whole items that were read are kept and
+//      in's failbit is set.
+//
+//   void save(std::ostream& out) const
+//    Pre:  out was opened in binary mode.
+//    Post: The items have been written to out in binary: the number of
+//      items as a 64-bit unsigned integer, then each item as an IEEE
+//      754 double, all little-endian regardless of the machine.
+//
 // VALUE SEMANTICS for the sequence class:
 //   Assignments and the copy constructor may be used with sequence
-//   objects.
+//   objects. Both are O(1): the copy shares the source's dynamic array
+//   until either sequence calls insert, attach, remove_current, resize,
+//   sort or set_sorted, which first gives that sequence its own copy
+//   (copy-on-write). The sharing count is atomic, so copies may be
+//   handed to other threads; one sequence object must still not be
+//   used by two threads at once.
 
 #ifndef SEQUENCE_H
 #define SEQUENCE_H
+#include <atomic>   // provides atomic
 #include <cstdlib>  // provides size_t
+#include <iosfwd>   // provides istream, ostream
+#include "SeqKernels.h"  // provides sum_mode and the array kernels
+#include "SequenceView.h"  // provides sequence_view
 
 namespace CS3358_Sp2016
 {
@@ -114,16 +241,58 @@ namespace CS3358_Sp2016
       void insert(const value_type& entry);
       void attach(const value_type& entry);
       void remove_current();
+      void sort();
+      void set_sorted(bool on);
       sequence& operator=(const sequence& source);
       // CONSTANT MEMBER FUNCTIONS
       size_type size() const;
       bool is_item() const;
       value_type current() const;
+      bool is_sorted_mode() const;
+      size_type find(const value_type& target) const;
+      // REDUCTIONS and SEARCHES
+      value_type sum(sum_mode mode = SUM_PLAIN) const;
+      value_type mean(sum_mode mode = SUM_PLAIN) const;
+      value_type min() const;
+      value_type max() const;
+      size_type argmin() const;
+      size_type argmax() const;
+      template <class Predicate>
+      size_type count_if(Predicate pred) const
+      {
+         size_type answer = 0;
+         for (size_type i = 0; i < used; ++i)
+            if (pred(data[i]))
+               ++answer;
+         return answer;
+      }
+      size_type find_first_greater(const value_type& threshold) const;
+      // SCANS and ROLLING WINDOWS
+      sequence inclusive_scan() const;
+      sequence exclusive_scan(value_type init = 0.0) const;
+      sequence rolling_window(size_type k, window_op op) const;
+      // BULK INPUT and OUTPUT
+      size_type load_text(std::istream& in);
+      void save_text(std::ostream& out) const;
+      size_type load(std::istream& in);
+      void save(std::ostream& out) const;
+      // VIEWS
+      sequence_view view() const;
+      sequence_view view(size_type first, size_type count,
+                         size_type stride = 1) const;
    private:
       value_type* data;
       size_type used;
       size_type current_index;
       size_type capacity;
+      bool sorted;
+      std::atomic<long>* refs;  // Number of sequences sharing data
+      // HELPER MEMBER FUNCTIONS
+      void insert_sorted(const value_type& entry);
+      void append_raw(const value_type& entry);
+      void finish_load(bool had_item);
+      void unshare();
+      void release();
    };
 }
 
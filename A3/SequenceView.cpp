@@ -0,0 +1,135 @@
+// FILE: SequenceView.cpp
+// CLASS IMPLEMENTED: sequence_view (see SequenceView.h for documentation)
+// INVARIANT for the sequence_view ADT:
+//   1. The items of the view are first[0], first[step], ...,
+//      first[(count - 1) * step]; step is at least 1.
+//   2. current_index is the position of the current item, or count if
+//      there is no current item.
+//   3. When step is 1 the items are contiguous and the reductions hand
+//      them straight to the SeqKernels functions.
+
+#include <cassert>
+#include "SequenceView.h"
+
+namespace CS3358_Sp2016
+{
+   // CONSTRUCTOR
+   sequence_view::sequence_view(const value_type* first, size_type count,
+                                size_type stride)
+      :first(first), count(count), step(stride), current_index(count)
+   {
+      assert(stride > 0);
+   }
+
+   // MODIFICATION MEMBER FUNCTIONS
+   void sequence_view::advance()
+   {
+      if (is_item())
+         ++current_index;
+   }
+
+   // CONSTANT MEMBER FUNCTIONS
+   sequence_view::value_type sequence_view::current() const
+   {
+      assert(is_item());
+      return first[current_index * step];
+   }
+
+   sequence_view::value_type sequence_view::operator [](size_type i) const
+   {
+      assert(i < count);
+      return first[i * step];
+   }
+
+   sequence_view sequence_view::slice(size_type pos, size_type n,
+                                      size_type every) const
+   {
+      assert(every > 0);
+      if (n == 0)
+         return sequence_view();
+      assert(pos + (n - 1) * every < count);
+      return sequence_view(first + pos * step, n, step * every);
+   }
+
+   // REDUCTIONS and SEARCHES
+   sequence_view::value_type sequence_view::sum(sum_mode mode) const
+   {
+      if (step == 1)
+         return seq_sum(first, count, mode);
+
+      double total = 0.0, carry = 0.0;
+      for (size_type i = 0; i < count; ++i)
+      {
+         if (mode == SUM_PLAIN)
+            total += first[i * step];
+         else
+         {                    //Kahan for both accurate modes.
+            double y = first[i * step] - carry;
+            double t = total + y;
+            carry = (t - total) - y;
+            total = t;
+         }
+      }
+      return total;
+   }
+
+   sequence_view::value_type sequence_view::mean(sum_mode mode) const
+   {
+      assert(count > 0);
+      return sum(mode) / count;
+   }
+
+   sequence_view::value_type sequence_view::min() const
+   {
+      assert(count > 0);
+      if (step == 1)
+         return seq_min(first, count);
+      return (*this)[argmin()];
+   }
+
+   sequence_view::value_type sequence_view::max() const
+   {
+      assert(count > 0);
+      if (step == 1)
+         return seq_max(first, count);
+      return (*this)[argmax()];
+   }
+
+   sequence_view::size_type sequence_view::argmin() const
+   {
+      assert(count > 0);
+      if (step == 1)
+         return seq_argmin(first, count);
+
+      size_type answer = 0;
+      for (size_type i = 1; i < count; ++i)
+         if (first[i * step] < first[answer * step])
+            answer = i;
+      return answer;
+   }
+
+   sequence_view::size_type sequence_view::argmax() const
+   {
+      assert(count > 0);
+      if (step == 1)
+         return seq_argmax(first, count);
+
+      size_type answer = 0;
+      for (size_type i = 1; i < count; ++i)
+         if (first[i * step] > first[answer * step])
+            answer = i;
+      return answer;
+   }
+
+   sequence_view::size_type sequence_view::find_first_greater
+      (const value_type& threshold) const
+   {
+      if (step == 1)
+         return seq_find_first_greater(first, count, threshold);
+
+      size_type i;
+      for (i = 0; i < count && !(first[i * step] > threshold); ++i)
+         ;//No work in the body of this loop.
+      return i;
+   }
+}
@@ -0,0 +1,153 @@
+// FILE: SequenceView.h
+// CLASS PROVIDED: sequence_view (part of the namespace CS3358_Sp2016)
+//   A non-owning, read-only window onto doubles stored elsewhere (usually
+//   a sequence; see sequence::view in Sequence.h): a pointer, a number of
+//   items and a stride. Creating a view or a slice of a view is O(1)
+//   and allocates nothing.
+//
+// WARNING: A view does not keep its items alive. It must not be used
+//   after the sequence it came from is destroyed or changed (insert,
+//   attach, remove_current, resize, sort or set_sorted), since any of
+//   these may move the sequence's items.
+//
+// TYPEDEFS for the sequence_view class:
+//   typedef double value_type
+//   typedef std::size_t size_type
+//   class const_iterator
+//     A forward iterator over the items of the view, in order.
+//
+// CONSTRUCTORS for the sequence_view class:
+//   sequence_view()
+//    Post: The view is empty.
+//
+//   sequence_view(const value_type* first, size_type count,
+//                 size_type stride = 1)
+//    Pre:  stride > 0, and if count > 0, first[0], first[stride], ...,
+//      first[(count - 1) * stride] are valid.
+//    Post: The view's items are those count values, in that order.
+//      There is no current item until start() is called.
+//
+// MODIFICATION MEMBER FUNCTIONS for the sequence_view class (these move
+// the view's own cursor; the viewed items are never changed):
+//   void start()
+//   void advance()
+//    As for sequence.
+//
+// CONSTANT MEMBER FUNCTIONS for the sequence_view class:
+//   size_type size() const
+//   bool is_item() const
+//   value_type current() const
+//    As for sequence.
+//
+//   size_type stride() const
+//    Post: The return value is the distance, in doubles, between
+//      neighbouring items of the view in memory.
+//
+//   value_type operator[](size_type i) const
+//    Pre:  i < size()
+//    Post: The return value is the item at position i (the first item
+//      is position 0).
+//
+//   sequence_view slice(size_type pos, size_type n,
+//                       size_type every = 1) const
+//    Pre:  every > 0, and if n > 0, pos + (n - 1) * every < size().
+//    Post: The return value views items pos, pos + every, ..., of this
+//      view (n of them).
+//
+//   const_iterator begin() const
+//   const_iterator end() const
+//    Post: Iterators to the first item and one past the last item.
+//
+//   sum, mean, min, max, argmin, argmax, count_if, find_first_greater
+//    As for sequence (see Sequence.h); positions are within the view.
+//    Views with stride 1 use the AVX2 kernels in SeqKernels.h; strided
+//    views use scalar loops.
+
+#ifndef SEQUENCEVIEW_H
+#define SEQUENCEVIEW_H
+#include <cstddef>   // provides size_t, ptrdiff_t
+#include <iterator>  // provides forward_iterator_tag
+#include "SeqKernels.h"  // provides sum_mode and the array kernels
+
+namespace CS3358_Sp2016
+{
+   class sequence_view
+   {
+   public:
+      // TYPEDEFS
+      typedef double value_type;
+      typedef std::size_t size_type;
+
+      class const_iterator
+      {
+      public:
+         typedef std::forward_iterator_tag iterator_category;
+         typedef double value_type;
+         typedef std::ptrdiff_t difference_type;
+         typedef const double* pointer;
+         typedef const double& reference;
+
+         const_iterator(const double* base = NULL, size_type index = 0,
+                        size_type step = 1)
+            : base(base), index(index), step(step) { }
+         const double& operator *() const { return base[index * step]; }
+         const_iterator& operator ++()  // Prefix ++
+            { ++index; return *this; }
+         const_iterator operator ++(int)  // Postfix ++
+            { const_iterator original(*this); ++index; return original; }
+         bool operator ==(const const_iterator& other) const
+            { return index == other.index && base == other.base; }
+         bool operator !=(const const_iterator& other) const
+            { return !(*this == other); }
+      private:
+         const double* base;
+         size_type index;  // Counted in items, so no pointer runs past
+         size_type step;   // the end of the viewed array.
+      };
+
+      // CONSTRUCTORS
+      sequence_view()
+         : first(NULL), count(0), step(1), current_index(0) { }
+      sequence_view(const value_type* first, size_type count,
+                    size_type stride = 1);
+      // MODIFICATION MEMBER FUNCTIONS
+      void start() { current_index = 0; }
+      void advance();
+      // CONSTANT MEMBER FUNCTIONS
+      size_type size() const { return count; }
+      size_type stride() const { return step; }
+      bool is_item() const { return current_index < count; }
+      value_type current() const;
+      value_type operator [](size_type i) const;
+      sequence_view slice(size_type pos, size_type n,
+                          size_type every = 1) const;
+      const_iterator begin() const
+         { return const_iterator(first, 0, step); }
+      const_iterator end() const
+         { return const_iterator(first, count, step); }
+      // REDUCTIONS and SEARCHES
+      value_type sum(sum_mode mode = SUM_PLAIN) const;
+      value_type mean(sum_mode mode = SUM_PLAIN) const;
+      value_type min() const;
+      value_type max() const;
+      size_type argmin() const;
+      size_type argmax() const;
+      template <class Predicate>
+      size_type count_if(Predicate pred) const
+      {
+         size_type answer = 0;
+         for (size_type i = 0; i < count; ++i)
+            if (pred(first[i * step]))
+               ++answer;
+         return answer;
+      }
+      size_type find_first_greater(const value_type& threshold) const;
+   private:
+      const value_type* first;   // Address of the first item
+      size_type count;           // Number of items
+      size_type step;            // Distance between items
+      size_type current_index;   // Cursor; == count means no current item
+   };
+}
+
+#endif
@@ -5,6 +5,9 @@
 //       specified in this header file. For both versions, the same
 //       documentation applies; simply replace sequence in the
 //       documentation with seqDouble or seqChar as appropriate.
+//       Both are instantiations of the sequence template in ../sequence.h
+//       (explicitly instantiated once, in sequence.cpp), so they share
+//       its memmove-based shifting for trivially copyable items.
 ///////////////////////////////////////////////////////////////////////
 // CLASS PROVIDED: sequence (a container class for a list of items,
 //                 where each list may have a designated item called
@@ -79,66 +82,21 @@
 //    Assignments and the copy constructor may be used with sequence
 //    objects.
 
-#ifndef SEQUENCE_H
-#define SEQUENCE_H
+#ifndef SEQUENCE_ALT_H
+#define SEQUENCE_ALT_H
 
-#include <cstdlib>  // provides size_t
+#include "../sequence.h"  // provides the sequence template
 
 namespace CS3358_SP16_A04
 {
-   class seqDouble
-   {
-   public:
-      // TYPEDEFS and MEMBER CONSTANTS
-      typedef double value_type;
-      typedef size_t size_type;
-      static const size_type CAPACITY = 10;
-      // CONSTRUCTOR
-      seqDouble();
-      // MODIFICATION MEMBER FUNCTIONS
-      void start();
-      void end();
-      void advance();
-      void move_back();
-      void add(const value_type& entry);
-      void remove_current();
-      // CONSTANT MEMBER FUNCTIONS
-      size_type size() const;
-      bool is_item() const;
-      value_type current() const;
-
-   private:
-      value_type data[CAPACITY];
-      size_type used;
-      size_type current_index;
-   };
-
-   class seqChar
-   {
-   public:
-      // TYPEDEFS and MEMBER CONSTANTS
-      typedef char value_type;
-      typedef size_t size_type;
-      static const size_type CAPACITY = 10;
-      // CONSTRUCTOR
-      seqChar();
-      // MODIFICATION MEMBER FUNCTIONS
-      void start();
-      void end();
-      void advance();
-      void move_back();
-      void add(const value_type& entry);
-      void remove_current();
-      // CONSTANT MEMBER FUNCTIONS
-      size_type size() const;
-      bool is_item() const;
-      value_type current() const;
+   typedef CS3358_SP16_A04_sequenceOfNum::sequence<double> seqDouble;
+   typedef CS3358_SP16_A04_sequenceOfNum::sequence<char> seqChar;
+}
 
-   private:
-      value_type data[CAPACITY];
-      size_type used;
-      size_type current_index;
-   };
+namespace CS3358_SP16_A04_sequenceOfNum
+{
+   extern template class sequence<double>;
+   extern template class sequence<char>;
 }
 
 #endif
@@ -1,10 +1,13 @@
 // FILE: sequenceTest.cpp
-// An interactive test program for the sequence class
+// An interactive test program for the sequence class (and for the find
+// function of the text_buffer class)
 
 #include <cctype>      // provides toupper
 #include <iostream>    // provides cout and cin
-#include <cstdlib>     // provides EXIT_SUCCESS
+#include <cstdlib>     // provides EXIT_SUCCESS, size_t
+#include <string>      // provides string
 #include "sequence.h"
+#include "text_buffer.h"
 using namespace std;
 using namespace CS3358_SP16_A04;
 
@@ -46,6 +49,22 @@ char get_character();
 //       can be read. The non-whitespace character read is returned.
 //       The input buffer is cleared of any extra input until and
 //       including the first newline character.
+size_t get_position();
+// Pre:  (none)
+// Post: The user is prompted to enter a position (a whole number). The
+//       prompt is repeated until one can be read. The position read is
+//       returned.
+string get_pattern();
+// Pre:  (none)
+// Post: The user is prompted to enter a pattern (a word with no
+//       whitespace in it). The pattern read is returned.
+void test_find(size_t pos, const string& pattern);
+// Pre:  (none)
+// Post: A text of three chunks of lowercase letters (abc...zabc...) has
+//       been made, with pattern copied over the letters at pos if it fits
+//       there (so a pos past the end leaves it out). The position that
+//       text_buffer::find gives for pattern in this text is printed to
+//       cout, and so is a warning if string::find gives another.
 
 int main(int argc, char *argv[])
 {
@@ -53,6 +72,7 @@ int main(int argc, char *argv[])
    seqChar s2;       // A sequence of char for testing
    int objectNum;    // A number to indicate selection of s1 or s2
    double numHold;   // Holder for a real number
+   size_t posHold;   // Holder for a position in a text
    char charHold;    // Holder for a character
    char choice;      // A command character entered by the user
 
@@ -247,6 +267,10 @@ int main(int argc, char *argv[])
                   cout << "s2 has no current item." << endl;
             }
             break;
+         case 'F':
+            posHold = get_position();
+            test_find(posHold, get_pattern());
+            break;
          case 'Q':
             cout << "Quit option selected...bye" << endl;
             break;
@@ -276,6 +300,7 @@ void print_menu()
    cout << "  S  Print the result from the size() function\n";
    cout << "  A  Add a new item with the add(...) function\n";
    cout << "  R  Activate the remove_current() function\n";
+   cout << "  F  Place a pattern in a text_buffer and find(...) it\n";
    cout << "  Q  Quit this test program" << endl;
 }
 
@@ -382,3 +407,60 @@ char get_character()
    cout << result << endl;
    return result;
 }
+
+size_t get_position()
+{
+   size_t result;
+
+   cout << "Enter a position: ";
+   cin  >> result;
+   while ( ! cin.good() )
+   {
+      cerr << "Invalid position input..." << endl;
+      cin.clear();
+      cin.ignore(999, '\n');
+      cout << "Re-enter a position: ";
+      cin  >> result;
+   }
+
+   cout << "You entered ";
+   cout << result << endl;
+   return result;
+}
+
+string get_pattern()
+{
+   string result;
+
+   cout << "Enter a pattern: ";
+   cin  >> result;
+
+   cout << "You entered ";
+   cout << result << endl;
+   return result;
+}
+
+void test_find(size_t pos, const string& pattern)
+{
+   string text(3 * text_buffer::CHUNK_SIZE, ' ');
+   size_t expected;
+   size_t found;
+
+   for (size_t i = 0; i < text.size(); ++i)
+      text[i] = char('a' + i % 26);
+   if (pos + pattern.size() <= text.size())
+      text.replace(pos, pattern.size(), pattern);
+
+   text_buffer buffer(text);  // Chunks of CHUNK_SIZE characters each
+   found = buffer.find(pattern);
+   expected = text.find(pattern);
+   if (expected == string::npos)
+      expected = text.size();
+
+   if (found < buffer.size())
+      cout << pattern << " found at position " << found << "." << endl;
+   else
+      cout << pattern << " not found." << endl;
+   if (found != expected)
+      cout << "But string::find gives " << expected << "!" << endl;
+}
@@ -0,0 +1,625 @@
+// FILE: text_buffer.cpp
+// CLASS IMPLEMENTED: text_buffer (see text_buffer.h for documentation).
+// INVARIANT for the text_buffer class:
+//   1. The text is the in-order concatenation of the chunks of the tree
+//      at root (NULL when the buffer is empty). Each node's chunk holds
+//      len characters, 1 <= len <= CHUNK_SIZE, in text[0..len-1].
+//   2. Each node's total is len plus the totals of its two subtrees, so
+//      root->total is the size of the buffer.
+//   3. Each node's priority is no greater than its parent's (a treap),
+//      which keeps the expected depth O(log(number of chunks)).
+//   4. The position of the current item is in current_index;
+//      current_index == size() means there is no current item.
+
+#include <algorithm> // provides min
+#include <cassert>   // provides assert
+#include <cstring>   // provides memchr, memcmp, memcpy, memmove
+#include <vector>    // provides vector
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "text_buffer.h"
+
+namespace CS3358_SP16_A04
+{
+   namespace
+   {
+      typedef text_buffer::size_type size_type;
+
+      // SEARCHES within one contiguous piece of text; each returns the
+      // offset of the first occurrence of p[0..m-1] in s[0..n-1], or n.
+      size_type search_naive(const char* s, size_type n,
+                             const char* p, size_type m)
+      {
+         //memchr to each candidate first character, then compare.
+         size_type i = 0;
+
+         while (i + m <= n)
+         {
+            const void* hit = std::memchr(s + i, p[0], n - m + 1 - i);
+            if (hit == NULL)
+               return n;
+            i = static_cast<const char*>(hit) - s;
+            if (std::memcmp(s + i + 1, p + 1, m - 1) == 0)
+               return i;
+            ++i;
+         }
+         return n;
+      }
+
+      size_type search_horspool(const char* s, size_type n,
+                                const char* p, size_type m,
+                                const size_type* shift)
+      {
+         //Compare the character under the pattern's last position; on a
+         //mismatch skip by how far that character is from the end of
+         //the pattern (m if it is not in the pattern).
+         const unsigned char last = p[m - 1];
+         size_type i = 0;
+
+         while (i + m <= n)
+         {
+            unsigned char c = s[i + m - 1];
+            if (c == last && std::memcmp(s + i, p, m - 1) == 0)
+               return i;
+            i += shift[c];
+         }
+         return n;
+      }
+
+#ifdef __SSE2__
+      size_type search_sse2(const char* s, size_type n,
+                            const char* p, size_type m)
+      {
+         //Candidates are positions whose first and last characters both
+         //match; 16 positions are tested per pair of compares.
+         const __m128i first = _mm_set1_epi8(p[0]);
+         const __m128i last = _mm_set1_epi8(p[m - 1]);
+         size_type i = 0;
+
+         for (; i + m - 1 + 16 <= n; i += 16)
+         {
+            __m128i a = _mm_loadu_si128
+               (reinterpret_cast<const __m128i*>(s + i));
+            __m128i b = _mm_loadu_si128
+               (reinterpret_cast<const __m128i*>(s + i + m - 1));
+            unsigned mask = _mm_movemask_epi8
+               (_mm_and_si128(_mm_cmpeq_epi8(a, first),
+                              _mm_cmpeq_epi8(b, last)));
+            while (mask != 0)
+            {
+               size_type at = i + __builtin_ctz(mask);
+               if (std::memcmp(s + at + 1, p + 1, m - 2) == 0)
+                  return at;
+               mask &= mask - 1;
+            }
+         }
+         return i + search_naive(s + i, n - i, p, m);
+      }
+#endif
+
+      size_type search(const char* s, size_type n,
+                       const char* p, size_type m, const size_type* shift)
+      {
+         //Pre: m >= 1.
+         if (n < m)
+            return n;
+         if (m == 1)
+         {
+            const void* hit = std::memchr(s, p[0], n);
+            return (hit == NULL) ? n : static_cast<const char*>(hit) - s;
+         }
+         if (m >= text_buffer::HORSPOOL_MIN)
+            return search_horspool(s, n, p, m, shift);
+#ifdef __SSE2__
+         return search_sse2(s, n, p, m);
+#else
+         return search_naive(s, n, p, m);
+#endif
+      }
+   }
+
+   //MEMBER CONSTANTS*******************************************
+   const text_buffer::size_type text_buffer::CHUNK_SIZE;
+   const text_buffer::size_type text_buffer::HORSPOOL_MIN;
+
+   //CONSTRUCTORS & DESTRUCTOR**********************************
+   text_buffer::text_buffer()
+      : root(NULL), current_index(0), seed(2463534242u) { }
+
+   text_buffer::text_buffer(const std::string& text)
+      : root(NULL), current_index(0), seed(2463534242u)
+   {
+      root = build(text.data(), text.size());
+      current_index = text.size();
+   }
+
+   text_buffer::text_buffer(const seqChar& source)
+      : root(NULL), current_index(0), seed(2463534242u)
+   {
+      seqChar walk(source);
+      size_type after = 0;  //Items from the current one to the end.
+      std::string text;
+
+      for ( ; walk.is_item(); walk.advance())
+         ++after;
+      for (walk.start(); walk.is_item(); walk.advance())
+         text += walk.current();
+      root = build(text.data(), text.size());
+      current_index = text.size() - after;
+   }
+
+   text_buffer::text_buffer(const text_buffer& source)
+      : root(clone(source.root)), current_index(source.current_index),
+        seed(source.seed) { }
+
+   text_buffer::~text_buffer()
+   {
+      destroy(root);
+   }
+
+   //MUTATORS & ITERATORS***************************************
+   void text_buffer::start() { current_index = 0; }
+
+   void text_buffer::end()
+   { current_index = (size() > 0) ? size() - 1 : 0; }
+
+   void text_buffer::advance()
+   {
+      assert( is_item() );
+      ++current_index;
+   }
+
+   void text_buffer::move_back()
+   {
+      assert( is_item() );
+      if (current_index == 0)
+         current_index = size();
+      else
+         --current_index;
+   }
+
+   void text_buffer::add(const value_type& entry)
+   {
+      size_type pos = is_item() ? current_index + 1 : 0;
+      char hold = entry;
+
+      insert_range(pos, &hold, 1);
+      current_index = pos;
+   }
+
+   void text_buffer::remove_current()
+   {
+      assert( is_item() );
+
+      remove_range(current_index, 1);
+   }
+
+   void text_buffer::seek(size_type pos)
+   {
+      assert(pos <= size());
+      current_index = pos;
+   }
+
+   void text_buffer::insert(const char* text, size_type n)
+   {
+      insert_range(current_index, text, n);
+      current_index += n;
+   }
+
+   void text_buffer::insert(const std::string& text)
+   {
+      insert(text.data(), text.size());
+   }
+
+   void text_buffer::erase(size_type n)
+   {
+      remove_range(current_index, std::min(n, size() - current_index));
+   }
+
+   text_buffer& text_buffer::operator=(const text_buffer& source)
+   {
+      if (this == &source)
+         return *this;
+
+      node* copy = clone(source.root);
+      destroy(root);
+      root = copy;
+      current_index = source.current_index;
+      return *this;
+   }
+
+   //HELPERS*******************************************************************
+   text_buffer::node* text_buffer::new_node(const char* text, size_type n)
+   {
+      //Pre: 1 <= n <= CHUNK_SIZE.
+      node* t = new node;
+
+      seed ^= seed << 13;  //xorshift32
+      seed ^= seed >> 17;
+      seed ^= seed << 5;
+      std::memcpy(t->text, text, n);
+      t->len = t->total = n;
+      t->priority = seed;
+      t->left = t->right = NULL;
+      return t;
+   }
+
+   text_buffer::node* text_buffer::build(const char* text, size_type n)
+   {
+      //Returns a tree holding text[0..n-1] in full chunks.
+      node* answer = NULL;
+
+      for (size_type i = 0; i < n; i += CHUNK_SIZE)
+         answer = merge(answer,
+                        new_node(text + i, std::min(CHUNK_SIZE, n - i)));
+      return answer;
+   }
+
+   void text_buffer::insert_range(size_type pos, const char* text,
+                                  size_type n)
+   {
+      if (n == 0)
+         return;
+      std::string hold(text, n);  //text may be part of this buffer.
+      node* t = root;
+      size_type offset = pos;
+
+      //Find the chunk that pos falls in, preferring the end of the chunk
+      //on its left at a boundary. If it has room, insert there and add n
+      //to the totals along the path.
+      while (t != NULL)
+      {
+         if (offset <= total(t->left) && t->left != NULL)
+            t = t->left;
+         else if (offset <= total(t->left) + t->len)
+            break;
+         else
+         {
+            offset -= total(t->left) + t->len;
+            t = t->right;
+         }
+      }
+      if (t != NULL && t->len + n <= CHUNK_SIZE)
+      {
+         node* target = t;
+         offset = pos;
+         for (t = root; t != target; )
+         {
+            t->total += n;
+            if (offset <= total(t->left) && t->left != NULL)
+               t = t->left;
+            else
+            {
+               offset -= total(t->left) + t->len;
+               t = t->right;
+            }
+         }
+         offset -= total(t->left);
+         std::memmove(t->text + offset + n, t->text + offset,
+                      t->len - offset);
+         std::memcpy(t->text + offset, hold.data(), n);
+         t->len += n;
+         t->total += n;
+         return;
+      }
+
+      //Otherwise cut the tree at pos and put new chunks between.
+      node* before;
+      node* after;
+      split(root, pos, before, after);
+      root = merge(merge(before, build(hold.data(), n)), after);
+   }
+
+   void text_buffer::remove_range(size_type pos, size_type n)
+   {
+      //Pre: pos + n <= size().
+      if (n == 0)
+         return;
+      node* t = root;
+      size_type offset = pos;
+
+      //If the characters lie inside one chunk and do not empty it, remove
+      //them there and subtract n from the totals along the path.
+      while (t != NULL)
+      {
+         if (offset < total(t->left))
+            t = t->left;
+         else if (offset < total(t->left) + t->len)
+            break;
+         else
+         {
+            offset -= total(t->left) + t->len;
+            t = t->right;
+         }
+      }
+      offset -= (t == NULL) ? 0 : total(t->left);
+      if (t != NULL && offset + n <= t->len && n < t->len)
+      {
+         node* target = t;
+         size_type at = offset;
+         offset = pos;
+         for (t = root; t != target; )
+         {
+            t->total -= n;
+            if (offset < total(t->left))
+               t = t->left;
+            else
+            {
+               offset -= total(t->left) + t->len;
+               t = t->right;
+            }
+         }
+         std::memmove(t->text + at, t->text + at + n, t->len - at - n);
+         t->len -= n;
+         t->total -= n;
+         return;
+      }
+
+      //Otherwise cut out the range and join what is left.
+      node* before;
+      node* middle;
+      node* after;
+      split(root, pos, before, after);
+      split(after, n, middle, after);
+      destroy(middle);
+      root = merge(before, after);
+   }
+
+   text_buffer::size_type text_buffer::total(const node* t)
+   { return (t == NULL) ? 0 : t->total; }
+
+   void text_buffer::update(node* t)
+   { t->total = total(t->left) + t->len + total(t->right); }
+
+   text_buffer::node* text_buffer::merge(node* a, node* b)
+   {
+      //Pre: every character of a comes before every character of b.
+      if (a == NULL)
+         return b;
+      if (b == NULL)
+         return a;
+      if (a->priority >= b->priority)
+      {
+         a->right = merge(a->right, b);
+         update(a);
+         return a;
+      }
+      b->left = merge(a, b->left);
+      update(b);
+      return b;
+   }
+
+   void text_buffer::split(node* t, size_type pos, node*& a, node*& b)
+   {
+      //Post: a holds the first pos characters of t and b the rest; a
+      //chunk that straddles pos is cut in two.
+      if (t == NULL)
+      {
+         a = b = NULL;
+         return;
+      }
+      size_type left = total(t->left);
+      if (pos <= left)
+      {
+         split(t->left, pos, a, t->left);
+         update(t);
+         b = t;
+      }
+      else if (pos >= left + t->len)
+      {
+         split(t->right, pos - left - t->len, t->right, b);
+         update(t);
+         a = t;
+      }
+      else
+      {
+         size_type cut = pos - left;
+         node* tail = new_node(t->text + cut, t->len - cut);
+         b = merge(tail, t->right);
+         t->len = cut;
+         t->right = NULL;
+         update(t);
+         a = t;
+      }
+   }
+
+   text_buffer::node* text_buffer::clone(const node* t)
+   {
+      if (t == NULL)
+         return NULL;
+      node* copy = new node(*t);
+      copy->left = copy->right = NULL;
+      try
+      {
+         copy->left = clone(t->left);
+         copy->right = clone(t->right);
+      }
+      catch (...)
+      {
+         destroy(copy);
+         throw;
+      }
+      return copy;
+   }
+
+   void text_buffer::destroy(node* t)
+   {
+      if (t == NULL)
+         return;
+      destroy(t->left);
+      destroy(t->right);
+      delete t;
+   }
+
+   void text_buffer::copy_range(const node* t, size_type pos, size_type n,
+                                char* out)
+   {
+      //Copies characters pos..pos+n-1 of the subtree t to out.
+      while (t != NULL && n > 0)
+      {
+         size_type left = total(t->left);
+         size_type k;
+         if (pos < left)
+         {
+            k = std::min(n, left - pos);
+            copy_range(t->left, pos, k, out);
+            out += k;
+            n -= k;
+            pos = left;
+         }
+         if (n > 0 && pos < left + t->len)
+         {
+            k = std::min(n, left + t->len - pos);
+            std::memcpy(out, t->text + (pos - left), k);
+            out += k;
+            n -= k;
+            pos = left + t->len;
+         }
+         pos -= left + t->len;
+         t = t->right;
+      }
+   }
+
+   //ACCESSORS*****************************************************************
+   text_buffer::size_type text_buffer::size() const { return total(root); }
+
+   bool text_buffer::is_item() const { return (current_index < size()); }
+
+   text_buffer::value_type text_buffer::current() const
+   {
+      assert( is_item() );
+
+      return (*this)[current_index];
+   }
+
+   text_buffer::size_type text_buffer::position() const
+   { return current_index; }
+
+   text_buffer::value_type text_buffer::operator[](size_type pos) const
+   {
+      assert(pos < size());
+      const node* t = root;
+
+      for (;;)
+      {
+         if (pos < total(t->left))
+            t = t->left;
+         else if (pos < total(t->left) + t->len)
+            return t->text[pos - total(t->left)];
+         else
+         {
+            pos -= total(t->left) + t->len;
+            t = t->right;
+         }
+      }
+   }
+
+   std::string text_buffer::substr(size_type pos, size_type n) const
+   {
+      assert(pos <= size());
+      std::string answer(std::min(n, size() - pos), '\0');
+
+      copy_range(root, pos, answer.size(), &answer[0]);
+      return answer;
+   }
+
+   std::string text_buffer::str() const { return substr(0, size()); }
+
+   text_buffer::size_type text_buffer::find(const char* pattern,
+                                            size_type m,
+                                            size_type from) const
+   {
+      assert(from <= size());
+      if (m == 0)
+         return from;
+      if (m > size() - from)
+         return size();
+
+      size_type shift[256];
+      if (m >= HORSPOOL_MIN)
+      {
+         for (size_type c = 0; c < 256; ++c)
+            shift[c] = m;
+         for (size_type j = 0; j + 1 < m; ++j)
+            shift[static_cast<unsigned char>(pattern[j])] = m - 1 - j;
+      }
+
+      //Descend to the chunk holding from, stacking the nodes whose
+      //chunks follow it; chunk_start is the position of each chunk.
+      std::vector<const node*> pending;
+      const node* t = root;
+      size_type chunk_start = 0;
+      size_type skip = from;
+      while (t != NULL)
+      {
+         size_type left = total(t->left);
+         if (skip < left)
+         {
+            pending.push_back(t);
+            t = t->left;
+         }
+         else if (skip < left + t->len)
+         {
+            pending.push_back(t);
+            chunk_start += left;
+            break;
+         }
+         else
+         {
+            skip -= left + t->len;
+            chunk_start += left + t->len;
+            t = t->right;
+         }
+      }
+
+      //Visit the chunks in order. carry holds the last m - 1 characters
+      //before the chunk (none before from), so that an occurrence that
+      //starts in an earlier chunk is found by searching carry followed
+      //by the first m - 1 characters of this chunk.
+      std::string carry, scratch;
+      size_type low = from - chunk_start; //Offset of from in first chunk.
+      while ( ! pending.empty() )
+      {
+         t = pending.back();
+         pending.pop_back();
+         for (const node* r = t->right; r != NULL; r = r->left)
+            pending.push_back(r);
+
+         const char* text = t->text + low;
+         size_type len = t->len - low;
+         size_type base = chunk_start + low;
+         size_type at;
+
+         if ( ! carry.empty() )
+         {
+            scratch = carry;
+            scratch.append(text, std::min(len, m - 1));
+            at = search(scratch.data(), scratch.size(), pattern, m, shift);
+            if (at < carry.size())
+               return base - carry.size() + at;
+         }
+         at = search(text, len, pattern, m, shift);
+         if (at < len)
+            return base + at;
+
+         if (len >= m - 1)
+            carry.assign(text + len - (m - 1), m - 1);
+         else
+         {
+            carry.append(text, len);
+            if (carry.size() > m - 1)
+               carry.erase(0, carry.size() - (m - 1));
+         }
+         chunk_start += t->len;
+         low = 0;
+      }
+      return size();
+   }
+
+   text_buffer::size_type text_buffer::find(const std::string& pattern,
+                                            size_type from) const
+   {
+      return find(pattern.data(), pattern.size(), from);
+   }
+}
@@ -0,0 +1,173 @@
+// FILE: text_buffer.h
+//////////////////////////////////////////////////////////////////////
+// NOTE: A sequence of characters for large texts. It has the same
+//       cursor interface as seqChar (see sequence.h), plus editing and
+//       searching at any position. The text is kept as a rope: a
+//       balanced tree (a treap) of chunks of up to CHUNK_SIZE
+//       characters, where each node records how many characters its
+//       subtree holds. Finding a position, and inserting or removing
+//       text there, therefore takes O(log n) steps plus the work on a
+//       single chunk, instead of shifting every character after it.
+//////////////////////////////////////////////////////////////////////
+// CLASS PROVIDED: text_buffer (a container class for a list of
+//                 characters, where each list may have a designated
+//                 character called the current item)
+//
+// TYPEDEFS and MEMBER CONSTANTS for the text_buffer class:
+//   typedef char value_type
+//   typedef size_t size_type
+//     As for seqChar.
+//   static const size_type CHUNK_SIZE = _____
+//     text_buffer::CHUNK_SIZE is the most characters held by one chunk.
+//
+// CONSTRUCTORS and DESTRUCTOR for the text_buffer class:
+//   text_buffer()
+//     Post: The buffer is empty.
+//   explicit text_buffer(const std::string& text)
+//     Post: The buffer holds the characters of text, and there is no
+//           current item.
+//   explicit text_buffer(const seqChar& source)
+//     Post: The buffer holds the items of source, in order, and the
+//           current item is at the same position as in source.
+//   text_buffer(const text_buffer& source)
+//     Post: The buffer is a copy of source (including the current item).
+//
+// MODIFICATION MEMBER FUNCTIONS for the text_buffer class:
+//   void start(), void end(), void advance(), void move_back(),
+//   void add(const value_type& entry), void remove_current()
+//     As for seqChar, except that add and remove_current are O(log n).
+//   void seek(size_type pos)
+//     Pre:  pos <= size().
+//     Post: The character at position pos (the first is position 0) is
+//           the current item; if pos == size(), there is none.
+//   void insert(const char* text, size_type n)
+//   void insert(const std::string& text)
+//     Pre:  text points to at least n characters.
+//     Post: The n characters have been inserted just before the current
+//           item (or at the end, if there is no current item). The
+//           current item is unchanged, so repeated inserts append to
+//           each other, as when typing.
+//   void erase(size_type n)
+//     Post: Up to n characters, starting with the current item, have
+//           been removed. The character after them (if any) is now the
+//           current item.
+//   text_buffer& operator=(const text_buffer& source)
+//     Post: The buffer is a copy of source.
+//
+// CONSTANT MEMBER FUNCTIONS for the text_buffer class:
+//   size_type size() const, bool is_item() const,
+//   value_type current() const
+//     As for seqChar; current is O(log n).
+//   size_type position() const
+//     Post: The return value is the position of the current item, or
+//           size() if there is no current item.
+//   value_type operator[](size_type pos) const
+//     Pre:  pos < size().
+//     Post: The return value is the character at position pos.
+//   std::string substr(size_type pos, size_type n) const
+//     Pre:  pos <= size().
+//     Post: The return value holds the (up to) n characters starting at
+//           position pos.
+//   std::string str() const
+//     Post: The return value holds the whole text.
+//   size_type find(const char* pattern, size_type m,
+//                  size_type from = 0) const
+//   size_type find(const std::string& pattern, size_type from = 0) const
+//     Pre:  pattern points to at least m characters; from <= size().
+//     Post: The return value is the position of the first occurrence of
+//           the pattern that starts at or after from, or size() if there
+//           is none. An empty pattern is found at from. Each chunk is
+//           searched in place: single characters with memchr, patterns
+//           of HORSPOOL_MIN or more characters with Horspool's skip
+//           table, and the others by comparing the pattern's first and
+//           last characters with 16 positions at a time (SSE2, where
+//           available). Occurrences that cross a chunk boundary are
+//           found from the last m - 1 characters carried over.
+//
+// VALUE SEMANTICS for the text_buffer class:
+//    Assignments and the copy constructor may be used with text_buffer
+//    objects.
+// DYNAMIC MEMORY USAGE by the text_buffer class:
+//    If there is insufficient dynamic memory, the following functions
+//    throw bad_alloc: the constructors, add, insert, erase, and the
+//    assignment operator.
+
+#ifndef TEXT_BUFFER_H
+#define TEXT_BUFFER_H
+
+#include <cstdlib>   // provides size_t
+#include <string>    // provides string
+#include "sequence.h" // provides seqChar
+
+namespace CS3358_SP16_A04
+{
+   class text_buffer
+   {
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef char value_type;
+      typedef size_t size_type;
+      static const size_type CHUNK_SIZE = 1024;
+      static const size_type HORSPOOL_MIN = 16;
+      // CONSTRUCTORS and DESTRUCTOR
+      text_buffer();
+      explicit text_buffer(const std::string& text);
+      explicit text_buffer(const seqChar& source);
+      text_buffer(const text_buffer& source);
+      ~text_buffer();
+      // MODIFICATION MEMBER FUNCTIONS
+      void start();
+      void end();
+      void advance();
+      void move_back();
+      void add(const value_type& entry);
+      void remove_current();
+      void seek(size_type pos);
+      void insert(const char* text, size_type n);
+      void insert(const std::string& text);
+      void erase(size_type n);
+      text_buffer& operator=(const text_buffer& source);
+      // CONSTANT MEMBER FUNCTIONS
+      size_type size() const;
+      bool is_item() const;
+      value_type current() const;
+      size_type position() const;
+      value_type operator[](size_type pos) const;
+      std::string substr(size_type pos, size_type n) const;
+      std::string str() const;
+      size_type find(const char* pattern, size_type m,
+                     size_type from = 0) const;
+      size_type find(const std::string& pattern, size_type from = 0) const;
+
+   private:
+      struct node
+      {
+         char text[CHUNK_SIZE];
+         size_type len;       // Characters used in text
+         size_type total;     // Characters in this subtree
+         unsigned priority;   // Heap order of the treap
+         node* left;
+         node* right;
+      };
+
+      // HELPER MEMBER FUNCTIONS
+      node* new_node(const char* text, size_type n);
+      node* build(const char* text, size_type n);
+      void insert_range(size_type pos, const char* text, size_type n);
+      void remove_range(size_type pos, size_type n);
+      static size_type total(const node* t);
+      static void update(node* t);
+      static node* merge(node* a, node* b);
+      void split(node* t, size_type pos, node*& a, node*& b);
+      static node* clone(const node* t);
+      static void destroy(node* t);
+      static void copy_range(const node* t, size_type pos, size_type n,
+                             char* out);
+
+      node* root;
+      size_type current_index;
+      unsigned seed;          // State of the priority generator
+   };
+}
+
+#endif
@@ -0,0 +1,137 @@
+// FILE: ring_sequence.h
+//////////////////////////////////////////////////////////////////////
+// NOTE: A sequence with the same cursor interface as sequence<T> (see
+//       sequence.h) whose items are kept in a circular buffer. Adding
+//       or removing an item at either end of the sequence is O(1)
+//       (amortized, when the buffer has to grow), so a ring_sequence
+//       suits sliding windows: push at one end, pop at the other.
+//       Adding or removing in the middle moves the items on the
+//       shorter side only. The buffer is never compacted; when full it
+//       doubles, and the items are moved once into the new buffer.
+//////////////////////////////////////////////////////////////////////
+// CLASS PROVIDED: ring_sequence (a container class for a list of items,
+//                 where each list may have a designated item called
+//                 the current item)
+//
+// TEMPLATE PARAMETERS, TYPEDEFS and MEMBER CONSTANTS:
+//   T, Allocator, value_type, allocator_type, size_type
+//     As for sequence<T, Allocator>.
+//   static const size_type DEFAULT_CAPACITY = _____
+//     ring_sequence::DEFAULT_CAPACITY is the size of the first buffer.
+//     Buffer sizes are always powers of two.
+//
+// CONSTRUCTORS and DESTRUCTOR for the ring_sequence class:
+//   ring_sequence(const allocator_type& alloc = allocator_type())
+//     Post: The sequence is empty and allocates with alloc. No memory
+//           is allocated until the first item is added.
+//   ring_sequence(const ring_sequence& source)
+//   ring_sequence(ring_sequence&& source)
+//     Post: As for sequence<T, Allocator>.
+//
+// MODIFICATION MEMBER FUNCTIONS for the ring_sequence class:
+//   void start(), void end(), void advance(), void move_back(),
+//   void add(const value_type& entry), void remove_current()
+//     As for sequence<T>. add with no current item and remove_current
+//     of the first or last item are O(1).
+//   void push_front(const value_type& entry)
+//   void push_back(const value_type& entry)
+//     Post: entry has been added as the new first (last) item. The
+//           current item is unchanged (and if there was no current
+//           item, there still is none).
+//   void pop_front()
+//   void pop_back()
+//     Pre:  size() > 0.
+//     Post: The first (last) item has been removed. If it was the
+//           current item, the item after it (if any) is now current.
+//           Otherwise the current item is unchanged.
+//   ring_sequence& operator=(const ring_sequence& source)
+//   ring_sequence& operator=(ring_sequence&& source)
+//     Post: As for sequence<T, Allocator>.
+//
+// CONSTANT MEMBER FUNCTIONS for the ring_sequence class:
+//   size_type size() const, bool is_item() const,
+//   value_type current() const
+//     As for sequence<T>.
+//   value_type front() const
+//   value_type back() const
+//     Pre:  size() > 0.
+//     Post: The return value is the first (last) item.
+//   size_type capacity() const
+//     Post: The number of items the buffer holds before it must grow.
+//
+// VALUE SEMANTICS for the ring_sequence class:
+//    Assignments and the copy constructor may be used with
+//    ring_sequence objects.
+//   DYNAMIC MEMORY USAGE by the ring_sequence class:
+//    If the allocator or a constructor of T throws while the buffer
+//    grows (in add or a push), the sequence is left as it was. Items
+//    are moved into the new buffer only if their move constructor is
+//    noexcept; otherwise they are copied. A copy constructor that
+//    throws leaves nothing behind.
+
+#ifndef RING_SEQUENCE_H
+#define RING_SEQUENCE_H
+
+#include <cstdlib>   // provides size_t
+#include <memory>    // provides allocator, allocator_traits
+
+namespace CS3358_SP16_A04_sequenceOfNum
+{
+   template <class T, class Allocator = std::allocator<T> >
+   class ring_sequence
+   {
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef T value_type;
+      typedef Allocator allocator_type;
+      typedef size_t size_type;
+      static const size_type DEFAULT_CAPACITY = 16;
+      // CONSTRUCTORS and DESTRUCTOR
+      explicit ring_sequence(const allocator_type& alloc = allocator_type());
+      ring_sequence(const ring_sequence& source);
+      ring_sequence(ring_sequence&& source) noexcept;
+      ~ring_sequence();
+      // MODIFICATION MEMBER FUNCTIONS
+      void start();
+      void end();
+      void advance();
+      void move_back();
+      void add(const value_type& entry);
+      void remove_current();
+      void push_front(const value_type& entry);
+      void push_back(const value_type& entry);
+      void pop_front();
+      void pop_back();
+      ring_sequence& operator=(const ring_sequence& source);
+      ring_sequence& operator=(ring_sequence&& source);
+      // CONSTANT MEMBER FUNCTIONS
+      size_type size() const;
+      size_type capacity() const;
+      bool is_item() const;
+      value_type current() const;
+      value_type front() const;
+      value_type back() const;
+
+   private:
+      typedef std::allocator_traits<Allocator> alloc_traits;
+
+      // HELPER MEMBER FUNCTIONS
+      value_type* slot(size_type i) const;  // Address of logical item i
+      void grow();
+      void insert_at(size_type pos, const value_type& entry);
+      void erase_at(size_type pos);
+      void clear();
+      void release();
+      void copy_from(const ring_sequence& source);
+
+      allocator_type alloc;
+      value_type* data;
+      size_type head;
+      size_type used;
+      size_type current_index;
+      size_type cap;
+   };
+}
+
+#include "ring_sequence.template" //Includes implementation.
+#endif
@@ -2,31 +2,79 @@
 //////////////////////////////////////////////////////////////////////
 // NOTE: A single template sequence class consisting of any type of
 //       element (double and char's used in test driver).
-//       
+//       When T is trivially copyable, the shifting done by add and
+//       remove_current is a single memmove; otherwise the items are
+//       shifted with move assignment.
+//       Storage is dynamic and obtained from the Allocator template
+//       parameter (std::allocator<T> by default). The first N items
+//       (N is the third template parameter, 0 by default) are kept in
+//       an inline buffer inside the sequence object, so a sequence that
+//       never grows past N never touches the allocator.
+//       pmr::sequence<T, N> is shorthand for a sequence that uses
+//       std::pmr::polymorphic_allocator<T>, e.g. to place many
+//       short-lived sequences in a std::pmr::monotonic_buffer_resource.
+//       sequence<bool> is specialized to store 64 items per word (see
+//       sequence_bool.h).
 //////////////////////////////////////////////////////////////////////
 // CLASS PROVIDED: sequence (a container class for a list of items,
 //                 where each list may have a designated item called
 //                 the current item)
 //
+// TEMPLATE PARAMETERS for the sequence class:
+//   T          the type of the items (see value_type below).
+//   Allocator  an allocator for T (std::allocator<T> by default).
+//   N          the number of items stored inline before the allocator
+//              is first used (0 by default).
+//
 // TYPEDEFS and MEMBER CONSTANTS for the sequence class:
 //   typedef ____ value_type
 //     sequence::value_type is the data type of the items in the sequence.
 //     It may be any of the C++ built-in types (int, char, etc.), or a
 //     class with a default constructor, an assignment operator, and a
 //     copy constructor.
+//   typedef ____ allocator_type
+//     sequence::allocator_type is the Allocator template parameter.
 //   typedef ____ size_type
 //     sequence::size_type is the data type of any variable that keeps
 //     track of how many items are in a sequence.
-//   static const size_type CAPACITY = _____
-//     sequence::CAPACITY is the maximum number of items that a
-//     sequence can hold.
+//   static const size_type DEFAULT_CAPACITY = _____
+//     sequence::DEFAULT_CAPACITY is the capacity of the first block
+//     obtained from the allocator when the inline buffer is outgrown.
+//   static const size_type INLINE_CAPACITY = _____
+//     sequence::INLINE_CAPACITY is N, the size of the inline buffer.
 //
-// CONSTRUCTOR for the sequence class:
-//   sequence()
+// CONSTRUCTORS and DESTRUCTOR for the sequence class:
+//   sequence(const allocator_type& alloc = allocator_type())
+//     Pre:  (none)
+//     Post: The sequence has been initialized as an empty sequence that
+//           allocates with alloc. Its capacity is INLINE_CAPACITY.
+//   sequence(size_type initial_capacity,
+//            const allocator_type& alloc = allocator_type())
 //     Pre:  (none)
-//     Post: The sequence has been initialized as an empty sequence.
+//     Post: The sequence has been initialized as an empty sequence that
+//           allocates with alloc. add will work without allocating
+//           until initial_capacity (or INLINE_CAPACITY if larger) items
+//           are held.
+//   sequence(const sequence& source)
+//   sequence(const sequence& source, const allocator_type& alloc)
+//     Post: The sequence is a copy of source (including the position of
+//           the current item). The first version obtains its allocator
+//           by select_on_container_copy_construction; the second uses
+//           alloc.
+//   sequence(sequence&& source)
+//     Post: The sequence holds the items that source held and source is
+//           empty. Heap storage is taken over without copying.
+//   ~sequence()
+//     Post: All items have been destroyed and storage returned to the
+//           allocator.
 //
 // MODIFICATION MEMBER FUNCTIONS for the sequence class:
+//   void reserve(size_type new_capacity)
+//     Pre:  (none)
+//     Post: capacity() >= new_capacity. add will work without allocating
+//           until new_capacity items are held.
+//           If the allocator or a constructor of T throws, the sequence
+//           is left as it was.
 //   void start()
 //     Pre:  (none)
 //     Post: The first item on the sequence becomes the current item
@@ -46,22 +94,32 @@
 //           there is no longer any current item. Otherwise, the new current
 //           item is the item immediately before the original current item.
 //   void add(const value_type& entry)
-//     Pre:  size() < CAPACITY.
+//     Pre:  (none)
 //     Post: A new copy of entry has been inserted in the sequence after
 //           the current item. If there was no current item, then the new
 //           entry has been inserted as new first item of the sequence. In
 //           either case, the newly added item is now the current item of
-//           the sequence.
+//           the sequence. The capacity doubles whenever it is reached.
 //   void remove_current()
 //     Pre:  is_item() returns true.
 //     Post: The current item has been removed from the sequence, and
 //           the item after this (if there is one) is now the new current
 //           item. If the current item was already the last item in the
 //           sequence, then there is no longer any current item.
+//   sequence& operator=(const sequence& source)
+//   sequence& operator=(sequence&& source)
+//     Post: The sequence is a copy of source (or, for the move version,
+//           holds the items source held, leaving source empty). The
+//           allocator is replaced only if the allocator's propagate_on_
+//           container_copy/move_assignment trait says so.
 // CONSTANT MEMBER FUNCTIONS for the sequence class:
 //   size_type size() const
 //     Pre:  (none)
 //     Post: The return value is the number of items in the sequence.
+//   size_type capacity() const
+//     Pre:  (none)
+//     Post: The return value is the number of items the sequence can
+//           hold before add must allocate.
 //   bool is_item() const
 //     Pre:  (none)
 //     Post: A true return value indicates that there is a valid
@@ -71,45 +129,97 @@
 //   value_type current() const
 //     Pre:  is_item() returns true.
 //     Post: The item returned is the current item in the sequence.
+//   allocator_type get_allocator() const
+//     Post: The return value is a copy of the sequence's allocator.
 //   VALUE SEMANTICS for the sequence class:
 //    Assignments and the copy constructor may be used with sequence
 //    objects.
+//   DYNAMIC MEMORY USAGE by the sequence class:
+//    If the allocator fails, it throws (bad_alloc for std::allocator)
+//    from: the constructors, reserve, add, and the assignment operators.
+//    Anything thrown by T's copy constructor is passed on; the copies
+//    already made are destroyed first, and a sequence being assigned to
+//    is left empty.
 
 #ifndef SEQUENCE_H
 #define SEQUENCE_H
 
-#include <cstdlib>  // provides size_t
+#include <cstdlib>           // provides size_t
+#include <memory>            // provides allocator, allocator_traits
+#include <memory_resource>   // provides pmr::polymorphic_allocator
+#include <type_traits>       // provides is_trivially_copyable, true_type
 
 namespace CS3358_SP16_A04_sequenceOfNum
 {
-   template <class T>
+   template <class T, class Allocator = std::allocator<T>, size_t N = 0>
    class sequence
    {
    public:
       // TYPEDEFS and MEMBER CONSTANTS
       typedef T value_type;
+      typedef Allocator allocator_type;
       typedef size_t size_type;
-      static const size_type CAPACITY = 10;
-      // CONSTRUCTOR
-      sequence();
+      static const size_type DEFAULT_CAPACITY = 10;
+      static const size_type INLINE_CAPACITY = N;
+      // CONSTRUCTORS and DESTRUCTOR
+      explicit sequence(const allocator_type& alloc = allocator_type());
+      explicit sequence(size_type initial_capacity,
+                        const allocator_type& alloc = allocator_type());
+      sequence(const sequence& source);
+      sequence(const sequence& source, const allocator_type& alloc);
+      sequence(sequence&& source) noexcept;
+      ~sequence();
       // MODIFICATION MEMBER FUNCTIONS
+      void reserve(size_type new_capacity);
       void start();
       void end();
       void advance();
       void move_back();
       void add(const value_type& entry);
       void remove_current();
+      sequence& operator=(const sequence& source);
+      sequence& operator=(sequence&& source);
       // CONSTANT MEMBER FUNCTIONS
       size_type size() const;
+      size_type capacity() const;
       bool is_item() const;
       value_type current() const;
+      allocator_type get_allocator() const;
 
    private:
-      value_type data[CAPACITY];
+      typedef std::allocator_traits<Allocator> alloc_traits;
+
+      // HELPER MEMBER FUNCTIONS (dispatch on is_trivially_copyable<T>)
+      void shift_right(size_type first);
+      void shift_left(size_type first);
+      void shift_right(size_type first, std::true_type);
+      void shift_right(size_type first, std::false_type);
+      void shift_left(size_type first, std::true_type);
+      void shift_left(size_type first, std::false_type);
+      // HELPER MEMBER FUNCTIONS (storage)
+      value_type* inline_data();
+      bool is_inline() const;
+      void copy_from(const sequence& source);
+      void take_from(sequence& source);
+      void clear();
+      void release();
+
+      allocator_type alloc;
+      value_type* data;
       size_type used;
       size_type current_index;
+      size_type cap;
+      alignas(T) unsigned char inline_buf[N > 0 ? N * sizeof(T) : 1];
    };
+
+   namespace pmr
+   {
+      template <class T, size_t N = 0>
+      using sequence = CS3358_SP16_A04_sequenceOfNum::sequence
+                          <T, std::pmr::polymorphic_allocator<T>, N>;
+   }
 }
 
 #include "sequence.template" //Includes implementation.
+#include "sequence_bool.h"     //Bit-packed sequence<bool>.
 #endif
@@ -1,10 +1,22 @@
 // FILE: sequenceTest.cpp
-// An interactive test program for the sequence class
+// An interactive test program for the sequence class (and, with the T
+// command, self-checking tests of the sequence templates)
 
+#include <algorithm>   // provides count
 #include <cctype>      // provides toupper
 #include <iostream>    // provides cout and cin
-#include <cstdlib>     // provides EXIT_SUCCESS
+#include <cstdlib>     // provides EXIT_SUCCESS, size_t
+#include <memory>      // provides allocator
+#include <memory_resource> // provides pmr::memory_resource and
+                           // pmr::monotonic_buffer_resource
+#include <set>         // provides set
+#include <stdexcept>   // provides runtime_error
+#include <string>      // provides string
+#include <utility>     // provides move
+#include <vector>      // provides vector
 #include "sequence.h"
+#include "ring_sequence.h"
+#include "static_sequence.h"
 namespace seqT  = CS3358_SP16_A04_sequenceOfNum;
 using namespace std;
 
@@ -44,6 +56,156 @@ char get_character();
 //       can be read. The non-whitespace character read is returned.
 //       The input buffer is cleared of any extra input until and
 //       including the first newline character.
+void run_tests();
+// Pre:  (none)
+// Post: Each group of self-checking tests below has been run, and a line
+//       saying whether it passed has been written to cout (after a line
+//       for each check that failed).
+bool test_storage();
+// Pre:  (none)
+// Post: The storage of the sequence template has been checked: the
+//       strong guarantee of reserve and add (and the cleanup done by
+//       copying) when copying an item throws, growth past the inline
+//       buffer, sequences in a pmr::monotonic_buffer_resource, and
+//       copies and moves between sequences with different allocators.
+//       The return value is true if all of the checks passed.
+bool test_shifting();
+// Pre:  (none)
+// Post: add and remove_current have been checked at the front, in the
+//       middle and at the end of sequences of double and char (which
+//       are shifted with memmove) and of string (which are shifted by
+//       move assignment), against a vector. The return value is true if
+//       all of the checks passed.
+template <class T>
+bool shift_items(const std::vector<T>& values);
+// Pre:  values.size() > 0
+// Post: A sequence<T> has been given many adds and remove_currents at
+//       every position, made from values, and checked against a vector
+//       after each. The return value is true if all of them matched.
+bool test_ring();
+// Pre:  (none)
+// Post: A ring_sequence has been given pushes and pops at both ends
+//       (wrapping around its buffer) and adds and removes in the middle,
+//       and checked against a vector after each; and its buffer has been
+//       made to grow while copying an item throws, which must leave it
+//       as it was. The return value is true if all of the checks passed.
+bool test_bool();
+// Pre:  (none)
+// Post: sequence<bool> (with and without inline words) has been given
+//       adds and remove_currents on both sides of word boundaries, and
+//       count and find_next_set have been checked from every position,
+//       against a vector<bool> after each change. The return value is
+//       true if all of the checks passed.
+bool test_static();
+// Pre:  (none)
+// Post: The functions that build static_sequences at compile time (see
+//       COMPILE-TIME TESTS below) have been run again at run time, and
+//       their results compared with the constexpr ones. The return value
+//       is true if they all matched.
+template <class Seq>
+bool bits_match(Seq& s, const std::vector<bool>& model);
+// Pre:  (none)
+// Post: The return value is true if the items of s are those of model,
+//       s.count() is the number of true items of model, and
+//       s.find_next_set(from) is the position of the next true item of
+//       model (or model.size() if there is none) for every from up to
+//       model.size() + 1. The current item of s is left at start().
+template <class Seq>
+void put_cursor(Seq& s, size_t position);
+// Pre:  position <= s.size()
+// Post: The current item of s is the one at position - 1, so that add
+//       puts its entry at position (for position 0, there is no current
+//       item, so add puts its entry first).
+template <class Seq, class V>
+bool holds(Seq& s, const std::vector<V>& items);
+// Pre:  (none)
+// Post: The return value is true if the items of s are items, in order
+//       (compared with ==). The current item of s is left at start().
+bool check(bool condition, const char message[]);
+// Pre:  (none)
+// Post: If condition is false, then message has been written to cout.
+//       The return value is condition.
+
+// COMPILE-TIME TESTS of static_sequence: each function below builds a
+// static_sequence in a constant expression, and the static_asserts after
+// it check the result, so a mistake stops this program from compiling.
+constexpr seqT::static_sequence<int, 10> static_squares()
+{
+   seqT::static_sequence<int, 10> answer;
+   for (int i = 0; i < 10; ++i)
+      answer.add(i * i);
+   return answer;
+}
+constexpr seqT::static_sequence<int, 10> STATIC_SQUARES = static_squares();
+static_assert(STATIC_SQUARES.size() == 10
+              && STATIC_SQUARES.size() == STATIC_SQUARES.CAPACITY,
+              "add did not fill a static_sequence.");
+static_assert(STATIC_SQUARES[0] == 0 && STATIC_SQUARES[3] == 9
+              && STATIC_SQUARES[9] == 81,
+              "add put items in the wrong places.");
+static_assert(STATIC_SQUARES.is_item() && STATIC_SQUARES.current() == 81,
+              "The last item added is not the current item.");
+
+constexpr seqT::static_sequence<int, 8> static_edits()
+{
+   seqT::static_sequence<int, 8> s;
+   s.add(1);         // 1
+   s.add(3);         // 1 3
+   s.start();
+   s.add(2);         // 1 2 3
+   s.end();
+   s.add(5);         // 1 2 3 5
+   s.move_back();
+   s.add(4);         // 1 2 3 4 5
+   s.start();
+   s.move_back();    // No current item, so add puts 0 first.
+   s.add(0);         // 0 1 2 3 4 5
+   s.add(s[5]);      // 0 5 1 2 3 4 5 (an item of s itself)
+   s.advance();
+   s.remove_current();   // 0 5 2 3 4 5
+   s.end();
+   s.remove_current();   // 0 5 2 3 4, and no current item
+   s.start();
+   s.remove_current();   // 5 2 3 4, with 5 current
+   return s;
+}
+constexpr seqT::static_sequence<int, 8> STATIC_EDITS = static_edits();
+static_assert(STATIC_EDITS.size() == 4 && STATIC_EDITS[0] == 5
+              && STATIC_EDITS[1] == 2 && STATIC_EDITS[2] == 3
+              && STATIC_EDITS[3] == 4,
+              "add or remove_current went wrong in a static_sequence.");
+static_assert(STATIC_EDITS.is_item() && STATIC_EDITS.current() == 5,
+              "The wrong item of a static_sequence is current.");
+
+template <class Seq>
+constexpr int static_total(Seq s)
+{
+   int total = 0;
+   for (s.start(); s.is_item(); s.advance())
+      total += s.current();
+   return total;
+}
+static_assert(static_total(STATIC_SQUARES) == 285
+              && static_total(STATIC_EDITS) == 14,
+              "start, advance and current do not visit every item.");
+
+constexpr bool static_copies_are_separate()
+{
+   seqT::static_sequence<int, 4> a;
+   a.add(1);
+   a.add(2);
+   seqT::static_sequence<int, 4> b(a);
+   b.start();
+   b.remove_current();
+   seqT::static_sequence<int, 4> c;
+   c = b;
+   c.add(7);
+   return a.size() == 2 && a[0] == 1 && a[1] == 2
+      && b.size() == 1 && b[0] == 2
+      && c.size() == 2 && c[0] == 2 && c[1] == 7;
+}
+static_assert(static_copies_are_separate(),
+              "A copy of a static_sequence shares its items.");
 
 int main(int argc, char *argv[])
 {
@@ -245,6 +407,9 @@ int main(int argc, char *argv[])
                   cout << "s2 has no current item." << endl;
             }
             break;
+         case 'T':
+            run_tests();
+            break;
          case 'Q':
             cout << "Quit option selected...bye" << endl;
             break;
@@ -274,6 +439,7 @@ void print_menu()
    cout << "  S  Print the result from the size() function\n";
    cout << "  A  Add a new item with the add(...) function\n";
    cout << "  R  Activate the remove_current() function\n";
+   cout << "  T  Run the self-checking tests of the sequence templates\n";
    cout << "  Q  Quit this test program" << endl;
 }
 
@@ -375,3 +541,604 @@ char get_character()
    cout << result << endl;
    return result;
 }
+
+// An item whose copy constructor throws once copies_left copies have been
+// made (copies_left < 0 means never). live counts the items in existence,
+// so that items left behind by a failed copy are noticed, and alive holds
+// their addresses, so that an item copied after it was destroyed is
+// noticed too (dead_copied is set). It has no move constructor, so the
+// sequence must copy it when it grows.
+struct fragile
+{
+   fragile(int v = 0) : value(v) { ++live; alive.insert(this); }
+   fragile(const fragile& source) : value(source.value)
+   {
+      if (alive.count(&source) == 0)
+         dead_copied = true;
+      if (copies_left == 0)
+         throw std::runtime_error("fragile: copy failed");
+      if (copies_left > 0)
+         --copies_left;
+      ++live;
+      alive.insert(this);
+   }
+   fragile& operator=(const fragile& source)
+   {
+      if (alive.count(&source) == 0)
+         dead_copied = true;
+      value = source.value;
+      return *this;
+   }
+   ~fragile() { --live; alive.erase(this); }
+
+   int value;
+   static int copies_left;
+   static int live;
+   static std::set<const fragile*> alive;
+   static bool dead_copied;
+};
+int fragile::copies_left = -1;
+int fragile::live = 0;
+std::set<const fragile*> fragile::alive;
+bool fragile::dead_copied = false;
+bool operator==(const fragile& item, int v) { return item.value == v; }
+
+// A memory resource that passes each request on to new and delete, and
+// counts the allocations made and the bytes not yet given back.
+class counting_resource : public std::pmr::memory_resource
+{
+public:
+   counting_resource() : allocations(0), outstanding(0) { }
+   size_t allocations;
+   size_t outstanding;
+private:
+   void* do_allocate(size_t bytes, size_t alignment) override
+   {
+      ++allocations;
+      outstanding += bytes;
+      return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+   }
+   void do_deallocate(void* p, size_t bytes, size_t alignment) override
+   {
+      outstanding -= bytes;
+      std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+   }
+   bool do_is_equal(const std::pmr::memory_resource& other)
+      const noexcept override { return this == &other; }
+};
+
+void run_tests()
+{
+   bool passed = true;
+
+   passed &= test_storage();
+   passed &= test_shifting();
+   passed &= test_ring();
+   passed &= test_bool();
+   passed &= test_static();
+   cout << (passed ? "All self-checking tests passed."
+                   : "SOME SELF-CHECKING TESTS FAILED.") << endl;
+}
+
+bool test_storage()
+{
+   typedef seqT::sequence<fragile> seqFragile;
+   typedef seqT::pmr::sequence<int> seqPmr;
+   bool passed = true;
+   bool thrown;
+   bool add_thrown;
+   vector<int> items;
+   size_t before;
+   int i;
+
+   // reserve and add leave the sequence as it was when a copy throws,
+   // and a copy that fails leaves no items behind.
+   {
+      seqFragile s;
+      for (i = 0; i < 10; ++i)
+      {
+         s.add(fragile(i));
+         items.push_back(i);
+      }
+      s.start();
+      s.advance();
+      before = s.capacity();
+      fragile::copies_left = 4;
+      thrown = false;
+      try { s.reserve(4 * before); }
+      catch (const std::runtime_error&) { thrown = true; }
+      fragile::copies_left = 1;
+      add_thrown = false;
+      try { s.end(); s.add(fragile(10)); }
+      catch (const std::runtime_error&) { add_thrown = true; }
+      fragile::copies_left = -1;
+      passed &= check(thrown && add_thrown && s.size() == 10
+                      && s.capacity() == before && fragile::live == 10,
+                      "A failed reserve or add changed the sequence.");
+      passed &= check(holds(s, items), "A failed reserve or add changed "
+                      "the items.");
+
+      fragile::copies_left = 5;
+      thrown = false;
+      try { seqFragile copy(s); }
+      catch (const std::runtime_error&) { thrown = true; }
+      fragile::copies_left = -1;
+      passed &= check(thrown && fragile::live == 10,
+                      "A failed copy constructor left items behind.");
+
+      seqFragile target;
+      target.add(fragile(99));
+      fragile::copies_left = 5;
+      thrown = false;
+      try { target = s; }
+      catch (const std::runtime_error&) { thrown = true; }
+      fragile::copies_left = -1;
+      passed &= check(thrown && target.size() == 0 && fragile::live == 10,
+                      "A failed assignment did not leave the target empty.");
+      target = s;
+      passed &= check(holds(target, items), "Assignment after a failed one "
+                      "went wrong.");
+   }
+   passed &= check(fragile::live == 0 && !fragile::dead_copied,
+                   "Items of a sequence were not destroyed, or were used "
+                   "after they were.");
+
+   // Up to N items are kept inline; the item after that goes to the
+   // allocator.
+   {
+      counting_resource counter;
+      seqT::pmr::sequence<int, 4> small(&counter);
+      seqT::sequence<string, std::allocator<string>, 4> words;
+      vector<string> texts;
+      items.clear();
+      for (i = 0; i < 4; ++i)
+      {
+         small.add(i);
+         items.push_back(i);
+         texts.push_back(string(20 + i, char('a' + i)));
+         words.add(texts.back());
+      }
+      passed &= check(small.capacity() == 4 && counter.allocations == 0
+                      && words.capacity() == 4,
+                      "A sequence within its inline buffer allocated.");
+      for (i = 4; i < 30; ++i)
+      {
+         small.add(i);
+         items.push_back(i);
+         texts.push_back(string(20 + i, char('a' + i)));
+         words.add(texts.back());
+      }
+      passed &= check(counter.allocations == 3 && small.capacity() == 40,
+                      "A sequence grew past its inline buffer wrongly.");
+      passed &= check(holds(small, items) && holds(words, texts),
+                      "The items went wrong past the inline buffer.");
+      seqT::sequence<string, std::allocator<string>, 4> moved
+         (std::move(words));
+      passed &= check(holds(moved, texts) && words.size() == 0,
+                      "Moving a grown sequence went wrong.");
+   }
+
+   // Many sequences may be made in a monotonic_buffer_resource, which
+   // hands out the pieces of a buffer (then of its upstream resource).
+   {
+      counting_resource upstream;
+      unsigned char buffer[4096];
+      {
+         std::pmr::monotonic_buffer_resource arena
+            (buffer, sizeof(buffer), &upstream);
+         seqPmr first(&arena);
+         items.clear();
+         for (i = 0; i < 500; ++i)
+         {
+            first.add(i);
+            items.push_back(i);
+         }
+         seqPmr second(first, &arena);
+         passed &= check(first.get_allocator().resource() == &arena
+                         && second.get_allocator().resource() == &arena,
+                         "A sequence did not keep its memory resource.");
+         passed &= check(holds(first, items) && holds(second, items),
+                         "A sequence in an arena went wrong.");
+         passed &= check(upstream.allocations > 0,
+                         "The arena was not outgrown.");
+      }
+      passed &= check(upstream.outstanding == 0,
+                      "The arena did not give back its memory.");
+   }
+
+   // Copies and moves between sequences with different allocators.
+   {
+      counting_resource r1;
+      counting_resource r2;
+      {
+         seqPmr a(&r1);
+         items.clear();
+         for (i = 0; i < 50; ++i)
+         {
+            a.add(i);
+            items.push_back(i);
+         }
+         seqPmr b(a, &r2);
+         passed &= check(b.get_allocator().resource() == &r2
+                         && r2.allocations > 0 && holds(b, items),
+                         "Copying with another allocator went wrong.");
+         seqPmr c(a);
+         passed &= check(c.get_allocator().resource()
+                            == std::pmr::get_default_resource()
+                         && holds(c, items),
+                         "A copy of a pmr sequence did not use the "
+                         "default resource.");
+         before = r2.allocations;
+         seqPmr d(std::move(b));
+         passed &= check(d.get_allocator().resource() == &r2
+                         && r2.allocations == before && holds(d, items)
+                         && b.size() == 0,
+                         "A move constructor did not take the storage.");
+         seqPmr e(&r2);
+         e.add(-1);
+         e = std::move(a);
+         passed &= check(e.get_allocator().resource() == &r2
+                         && holds(e, items) && a.size() == 0,
+                         "Moving between different allocators went wrong.");
+         a = e;
+         passed &= check(a.get_allocator().resource() == &r1
+                         && holds(a, items),
+                         "Assigning between different allocators went "
+                         "wrong.");
+      }
+      passed &= check(r1.outstanding == 0 && r2.outstanding == 0,
+                      "A sequence did not give back its storage.");
+   }
+
+   cout << "storage tests " << (passed ? "passed." : "FAILED.") << endl;
+   return passed;
+}
+
+bool test_shifting()
+{
+   vector<double> numbers;
+   vector<char> letters;
+   vector<string> words;
+   bool passed = true;
+   int i;
+
+   for (i = 0; i < 26; ++i)
+   {
+      numbers.push_back(i + 0.5);
+      letters.push_back(char('a' + i));
+      // Long enough not to fit in a short string's own buffer.
+      words.push_back(string(i + 20, char('A' + i)));
+   }
+   words.push_back("");
+   passed &= check(shift_items(numbers), "Shifting doubles went wrong.");
+   passed &= check(shift_items(letters), "Shifting chars went wrong.");
+   passed &= check(shift_items(words), "Shifting strings went wrong.");
+
+   cout << "shifting tests " << (passed ? "passed." : "FAILED.") << endl;
+   return passed;
+}
+
+template <class T>
+bool shift_items(const std::vector<T>& values)
+{
+   seqT::sequence<T> s;
+   vector<T> model;     // The items s should hold
+   size_t position;     // The index of s's current item in model
+   size_t step;
+   size_t i;
+
+   for (step = 0; step < 400; ++step)
+   {
+      // Puts the cursor at the front, the back, or somewhere in between.
+      s.start();
+      position = 0;
+      if (step % 3 == 1 && s.size() > 0)
+      {
+         s.end();
+         position = s.size() - 1;
+      }
+      else if (step % 3 == 2)
+         for (i = 0; i < step % 7 && s.is_item(); ++i)
+         {
+            s.advance();
+            ++position;
+         }
+
+      // Mostly adds, so the sequence grows, with removes between.
+      if (step % 5 < 3 || !s.is_item())
+      {
+         if (!s.is_item())
+            position = 0;
+         else
+            ++position;
+         s.add(values[step % values.size()]);
+         model.insert(model.begin() + position, values[step % values.size()]);
+      }
+      else
+      {
+         s.remove_current();
+         model.erase(model.begin() + position);
+         if (s.is_item() != (position < model.size())
+             || (s.is_item() && !(s.current() == model[position])))
+            return false;
+      }
+      if (!holds(s, model))
+         return false;
+   }
+   return true;
+}
+
+bool test_ring()
+{
+   typedef seqT::ring_sequence<fragile> ringFragile;
+   seqT::ring_sequence<string> words;
+   vector<string> model;
+   string word;
+   bool passed = true;
+   bool thrown;
+   size_t step;
+   size_t i;
+
+   // A window that slides along: push at the back, pop at the front, so
+   // the items wrap around the end of the buffer many times. Every few
+   // steps an item is added or removed in the middle too.
+   for (step = 0; step < 600 && passed; ++step)
+   {
+      word = string(20, char('a' + step % 26)) + char('0' + step % 10);
+      words.push_back(word);
+      model.push_back(word);
+      if (step % 3 == 0 && model.size() > 5)
+      {
+         words.pop_front();
+         model.erase(model.begin());
+         words.pop_front();
+         model.erase(model.begin());
+      }
+      if (step % 7 == 0)
+      {
+         words.push_front("front");
+         model.insert(model.begin(), "front");
+      }
+      if (step % 11 == 0 && model.size() > 2)
+      {
+         words.pop_back();
+         model.pop_back();
+      }
+      if (step % 5 == 0)
+      {
+         words.start();
+         for (i = 0; i < model.size() / 3; ++i)
+            words.advance();
+         words.add("middle");
+         model.insert(model.begin() + i + 1, "middle");
+         if (step % 10 == 0)
+         {
+            words.move_back();
+            words.remove_current();
+            model.erase(model.begin() + i);
+         }
+      }
+      passed &= check(holds(words, model) && words.front() == model.front()
+                      && words.back() == model.back(),
+                      "A ring_sequence went wrong as it wrapped around.");
+   }
+
+   // Growing the buffer copies each item (fragile cannot be moved
+   // without the risk of a throw); a copy that throws part way must leave
+   // the sequence as it was.
+   {
+      ringFragile r;
+      vector<int> items;
+      for (i = 0; i < 16; ++i)
+      {
+         r.push_front(fragile(int(i)));
+         items.insert(items.begin(), int(i));
+      }
+      r.pop_back();
+      items.pop_back();
+      r.push_front(fragile(16));       // The items now wrap around.
+      items.insert(items.begin(), 16);
+      r.start();
+      r.advance();
+      fragile::copies_left = 9;
+      thrown = false;
+      try { r.push_back(fragile(17)); }
+      catch (const std::runtime_error&) { thrown = true; }
+      fragile::copies_left = -1;
+      passed &= check(thrown && r.size() == 16 && r.capacity() == 16
+                      && fragile::live == 16,
+                      "A failed grow changed the ring_sequence.");
+      passed &= check(holds(r, items) && !fragile::dead_copied,
+                      "A failed grow changed or destroyed the items.");
+      r.push_back(fragile(17));
+      items.push_back(17);
+      passed &= check(r.capacity() == 32 && holds(r, items),
+                      "Growing after a failed grow went wrong.");
+      fragile::copies_left = 5;
+      thrown = false;
+      try { ringFragile copy(r); }
+      catch (const std::runtime_error&) { thrown = true; }
+      fragile::copies_left = -1;
+      passed &= check(thrown && fragile::live == 17,
+                      "A failed copy constructor left items behind.");
+   }
+   passed &= check(fragile::live == 0 && !fragile::dead_copied,
+                   "Items of a ring_sequence were not destroyed, or were "
+                   "used after they were.");
+
+   cout << "ring_sequence tests " << (passed ? "passed." : "FAILED.") << endl;
+   return passed;
+}
+
+bool test_bool()
+{
+   typedef seqT::sequence<bool, allocator<bool>, 100> seqInline;
+   // Positions on each side of the first word boundaries.
+   const size_t SPOTS[] = { 0, 1, 62, 63, 64, 65, 127, 128, 129, 191, 200 };
+   seqT::sequence<bool> s;
+   seqInline small;     // 128 items inline, then on the heap
+   vector<bool> model;  // The items s and small should hold
+   vector<size_t> set_at;
+   bool passed = true;
+   unsigned state = 37;
+   size_t spot;
+   size_t i;
+   size_t j;
+   int value;
+
+   // 250 items, about a third of them true; each add appends.
+   for (i = 0; i < 250; ++i)
+   {
+      state = state * 1103515245u + 12345u;
+      model.push_back((state >> 16) % 3 == 0);
+      s.add(model.back());
+      small.add(model.back());
+   }
+   passed &= check(bits_match(s, model) && bits_match(small, model),
+                   "A sequence<bool> went wrong as it was filled.");
+
+   // Each add and remove moves the bits after it across word boundaries.
+   for (j = 0; j < sizeof(SPOTS) / sizeof(SPOTS[0]); ++j)
+      for (value = 0; value < 2; ++value)
+      {
+         spot = SPOTS[j];
+         put_cursor(s, spot);
+         put_cursor(small, spot);
+         s.add(value == 1);
+         small.add(value == 1);
+         model.insert(model.begin() + spot, value == 1);
+         passed &= check(s.current() == (value == 1)
+                         && bits_match(s, model) && bits_match(small, model),
+                         "add went wrong in a sequence<bool>.");
+         put_cursor(s, spot + 1);
+         put_cursor(small, spot + 1);
+         s.remove_current();
+         small.remove_current();
+         model.erase(model.begin() + spot);
+         passed &= check(bits_match(s, model) && bits_match(small, model),
+                         "remove_current went wrong in a sequence<bool>.");
+      }
+
+   // A true item at the end, removed again, must not still be counted.
+   s.end();
+   s.add(true);
+   passed &= check(s.count() == size_t(count(model.begin(), model.end(),
+                                             true)) + 1
+                   && s.find_next_set(model.size()) == model.size(),
+                   "A true item added at the end was not found.");
+   s.end();
+   s.remove_current();
+   passed &= check(bits_match(s, model), "Removing the last item of a "
+                   "sequence<bool> left it counted.");
+
+   // Copies and moves keep the bits.
+   seqT::sequence<bool> copy(s);
+   seqInline moved(std::move(small));
+   passed &= check(bits_match(copy, model) && bits_match(moved, model),
+                   "A copied or moved sequence<bool> went wrong.");
+
+   // A sparse sequence: find_next_set steps from one true item to the next
+   // across whole words of false items.
+   const size_t SET[] = { 0, 63, 64, 127, 128, 255, 256, 299 };
+   seqT::sequence<bool> sparse;
+   model.assign(300, false);
+   for (i = 0; i < sizeof(SET) / sizeof(SET[0]); ++i)
+      model[SET[i]] = true;
+   for (i = 0; i < model.size(); ++i)
+      sparse.add(model[i]);
+   passed &= check(bits_match(sparse, model), "A sparse sequence<bool> "
+                   "went wrong.");
+   for (i = sparse.find_next_set(0); i < sparse.size();
+        i = sparse.find_next_set(i + 1))
+      set_at.push_back(i);
+   passed &= check(set_at == vector<size_t>(SET, SET + sizeof(SET)
+                                             / sizeof(SET[0])),
+                   "find_next_set did not step through the true items.");
+
+   cout << "sequence<bool> tests " << (passed ? "passed." : "FAILED.")
+        << endl;
+   return passed;
+}
+
+bool test_static();
+// Pre:  (none)
+// Post: The functions that build static_sequences at compile time (see
+//       COMPILE-TIME TESTS below) have been run again at run time, and
+//       their results compared with the constexpr ones. The return value
+//       is true if they all matched.
+bool test_static()
+{
+   // Not constexpr, so these run at run time (with the asserts on).
+   seqT::static_sequence<int, 10> squares = static_squares();
+   seqT::static_sequence<int, 8> edits = static_edits();
+   bool passed = true;
+   size_t i;
+
+   for (i = 0; i < STATIC_SQUARES.size(); ++i)
+      passed &= check(squares[i] == STATIC_SQUARES[i], "static_squares "
+                      "gave other items at run time.");
+   passed &= check(squares.size() == STATIC_SQUARES.size()
+                   && edits.size() == STATIC_EDITS.size()
+                   && static_total(edits) == static_total(STATIC_EDITS)
+                   && edits.current() == STATIC_EDITS.current(),
+                   "static_edits gave other items at run time.");
+   passed &= check(static_copies_are_separate(), "A copy of a "
+                   "static_sequence shares its items at run time.");
+
+   cout << "static_sequence tests " << (passed ? "passed." : "FAILED.")
+        << endl;
+   return passed;
+}
+
+template <class Seq>
+bool bits_match(Seq& s, const std::vector<bool>& model)
+{
+   size_t next = model.size();
+   size_t from;
+
+   if (!holds(s, model)
+       || s.count() != size_t(count(model.begin(), model.end(), true)))
+      return false;
+   // Walking down, next is the first true item at or after from.
+   for (from = model.size() + 2; from-- > 0; )
+   {
+      if (from < model.size() && model[from])
+         next = from;
+      if (s.find_next_set(from) != next)
+         return false;
+   }
+   return true;
+}
+
+template <class Seq>
+void put_cursor(Seq& s, size_t position)
+{
+   size_t i;
+
+   s.start();
+   if (position == 0 && s.is_item())
+      s.move_back();
+   for (i = 1; i < position; ++i)
+      s.advance();
+}
+
+template <class Seq, class V>
+bool holds(Seq& s, const std::vector<V>& items)
+{
+   size_t i = 0;
+
+   if (s.size() != items.size())
+      return false;
+   for (s.start(); s.is_item(); s.advance())
+      if (!(s.current() == items[i++]))
+         return false;
+   s.start();
+   return i == items.size();
+}
+
+bool check(bool condition, const char message[])
+{
+   if (!condition)
+      cout << message << endl;
+   return condition;
+}
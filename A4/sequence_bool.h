@@ -0,0 +1,114 @@
+// FILE: sequence_bool.h
+//////////////////////////////////////////////////////////////////////
+// NOTE: A specialization of sequence (see sequence.h) for bool that
+//       packs the items 64 to a word, using one eighth of the memory
+//       of a byte per item. It is included by sequence.h, so any
+//       sequence<bool, Allocator, N> is this class.
+//       add and remove_current shift the items after the current one
+//       a word at a time (each word shifted by one bit, carrying the
+//       bit that crosses into the next word), so the cost is
+//       proportional to the number of words moved, not items.
+//       The allocator is rebound to allocate words; N inline items
+//       are rounded up to whole words.
+//////////////////////////////////////////////////////////////////////
+// CLASS PROVIDED: sequence<bool, Allocator, N>
+//
+// The TYPEDEFS, CONSTRUCTORS, MODIFICATION and CONSTANT MEMBER
+// FUNCTIONS, VALUE SEMANTICS and DYNAMIC MEMORY USAGE are as for the
+// sequence template, with capacities counted in items (bits) and
+// always a multiple of WORD_BITS. In addition:
+//
+//   typedef std::uint64_t word_type
+//   static const size_type WORD_BITS = 64
+//     The items are stored in an array of word_type; item i is bit
+//     i % WORD_BITS of word i / WORD_BITS.
+//
+// ADDITIONAL CONSTANT MEMBER FUNCTIONS for sequence<bool>:
+//   size_type count() const
+//     Pre:  (none)
+//     Post: The return value is the number of items that are true,
+//           counted a word at a time with popcount.
+//   size_type find_next_set(size_type from) const
+//     Pre:  (none)
+//     Post: The return value is the position of the first true item at
+//           or after position from (the first item is position 0), or
+//           size() if there is none. Whole words of false items are
+//           skipped with one test each. The current item is unchanged.
+
+#ifndef SEQUENCE_BOOL_H
+#define SEQUENCE_BOOL_H
+
+#include <cstdint>   // provides uint64_t
+#include "sequence.h" // provides the sequence template
+
+namespace CS3358_SP16_A04_sequenceOfNum
+{
+   template <class Allocator, size_t N>
+   class sequence<bool, Allocator, N>
+   {
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef bool value_type;
+      typedef Allocator allocator_type;
+      typedef size_t size_type;
+      typedef std::uint64_t word_type;
+      static const size_type WORD_BITS = 64;
+      static const size_type DEFAULT_CAPACITY = WORD_BITS;
+      static const size_type INLINE_CAPACITY =
+         (N + WORD_BITS - 1) / WORD_BITS * WORD_BITS;
+      // CONSTRUCTORS and DESTRUCTOR
+      explicit sequence(const allocator_type& alloc = allocator_type());
+      explicit sequence(size_type initial_capacity,
+                        const allocator_type& alloc = allocator_type());
+      sequence(const sequence& source);
+      sequence(const sequence& source, const allocator_type& alloc);
+      sequence(sequence&& source) noexcept;
+      ~sequence();
+      // MODIFICATION MEMBER FUNCTIONS
+      void reserve(size_type new_capacity);
+      void start();
+      void end();
+      void advance();
+      void move_back();
+      void add(const value_type& entry);
+      void remove_current();
+      sequence& operator=(const sequence& source);
+      sequence& operator=(sequence&& source);
+      // CONSTANT MEMBER FUNCTIONS
+      size_type size() const;
+      size_type capacity() const;
+      bool is_item() const;
+      value_type current() const;
+      allocator_type get_allocator() const;
+      size_type count() const;
+      size_type find_next_set(size_type from) const;
+
+   private:
+      typedef typename std::allocator_traits<Allocator>::template
+         rebind_alloc<word_type> word_allocator;
+      typedef std::allocator_traits<word_allocator> word_traits;
+      static const size_type INLINE_WORDS = INLINE_CAPACITY / WORD_BITS;
+
+      // HELPER MEMBER FUNCTIONS
+      static size_type words_for(size_type bits);
+      void shift_right(size_type first);
+      void shift_left(size_type first);
+      void set(size_type i, bool value);
+      word_type* inline_data();
+      bool is_inline() const;
+      void copy_from(const sequence& source);
+      void take_from(sequence& source);
+      void clear();
+      void release();
+
+      word_allocator alloc;
+      word_type* words;
+      size_type used;
+      size_type current_index;
+      size_type cap;        // In items; always a multiple of WORD_BITS
+      word_type inline_buf[INLINE_WORDS > 0 ? INLINE_WORDS : 1];
+   };
+}
+
+#include "sequence_bool.template" //Includes implementation.
+#endif
@@ -0,0 +1,99 @@
+// FILE: static_sequence.h
+//////////////////////////////////////////////////////////////////////
+// NOTE: A sequence with the same cursor interface as sequence<T> (see
+//       sequence.h) whose items live in a fixed array of N slots
+//       inside the object, so it never allocates. Every member
+//       function is constexpr: a static_sequence can be filled by a
+//       constexpr function and the result stored in a constexpr
+//       variable, giving a lookup table that is built by the compiler
+//       rather than at program start-up. For example:
+//
+//           constexpr static_sequence<int, 10> squares()
+//           {
+//              static_sequence<int, 10> answer;
+//              for (int i = 0; i < 10; ++i)
+//                 answer.add(i * i);
+//              return answer;
+//           }
+//           constexpr static_sequence<int, 10> SQUARES = squares();
+//           static_assert(SQUARES[3] == 9, "");
+//
+//       To be usable in constant expressions T must be a literal type
+//       (e.g. a built-in type) with a default constructor; all N slots
+//       are default-initialized when the sequence is created.
+//////////////////////////////////////////////////////////////////////
+// CLASS PROVIDED: static_sequence (a container class for a list of
+//                 at most N items, where each list may have a
+//                 designated item called the current item)
+//
+// TEMPLATE PARAMETERS, TYPEDEFS and MEMBER CONSTANTS:
+//   T, value_type, size_type
+//     As for sequence<T>.
+//   static const size_type CAPACITY = N
+//     static_sequence::CAPACITY is the maximum number of items that a
+//     static_sequence can hold.
+//
+// CONSTRUCTOR for the static_sequence class:
+//   static_sequence()
+//     Post: The sequence is empty.
+//
+// MODIFICATION MEMBER FUNCTIONS for the static_sequence class:
+//   void start(), void end(), void advance(), void move_back(),
+//   void remove_current()
+//     As for sequence<T>.
+//   void add(const value_type& entry)
+//     Pre:  size() < CAPACITY.
+//     Post: As for sequence<T>.
+//
+// CONSTANT MEMBER FUNCTIONS for the static_sequence class:
+//   size_type size() const, bool is_item() const,
+//   value_type current() const
+//     As for sequence<T>.
+//   const value_type& operator[](size_type i) const
+//     Pre:  i < size().
+//     Post: The return value is the item at position i (the first item
+//           is position 0). The current item is unchanged.
+//
+// VALUE SEMANTICS for the static_sequence class:
+//    Assignments and the copy constructor may be used with
+//    static_sequence objects (both are constexpr).
+
+#ifndef STATIC_SEQUENCE_H
+#define STATIC_SEQUENCE_H
+
+#include <cstdlib>   // provides size_t
+
+namespace CS3358_SP16_A04_sequenceOfNum
+{
+   template <class T, size_t N>
+   class static_sequence
+   {
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef T value_type;
+      typedef size_t size_type;
+      static const size_type CAPACITY = N;
+      // CONSTRUCTOR
+      constexpr static_sequence();
+      // MODIFICATION MEMBER FUNCTIONS
+      constexpr void start();
+      constexpr void end();
+      constexpr void advance();
+      constexpr void move_back();
+      constexpr void add(const value_type& entry);
+      constexpr void remove_current();
+      // CONSTANT MEMBER FUNCTIONS
+      constexpr size_type size() const;
+      constexpr bool is_item() const;
+      constexpr value_type current() const;
+      constexpr const value_type& operator[](size_type i) const;
+
+   private:
+      value_type data[N > 0 ? N : 1];
+      size_type used;
+      size_type current_index;
+   };
+}
+
+#include "static_sequence.template" //Includes implementation.
+#endif
@@ -1,7 +1,7 @@
 // FILE: bag4.h (part of the namespace main_savitch_6A)
-// TEMPLATE CLASS PROVIDED: bag<item>
+// TEMPLATE CLASS PROVIDED: bag<item, Sorted>
 //
-// TEMPLATE PARAMETER, TYPEDEFS and MEMBER CONSTANTS for the bag<Item> class:
+// TEMPLATE PARAMETERS, TYPEDEFS and MEMBER CONSTANTS for the bag<Item> class:
 //   The template parameter, Item, is the data type of the items in the bag,
 //   also defined as bag<Item>::value_type. It may be any of the C++ built-in
 //   types (int, char, etc.), or a class with a default constructor, an
@@ -10,6 +10,11 @@
 //   of any variable that keeps track of how many items are in a bag. The static
 //   const DEFAULT_CAPACITY is the initial capacity of a bag created by the
 //   default constructor.
+//   The second template parameter, Sorted, is false by default. A bag with
+//   Sorted true keeps most of its items in order, for bags that are counted
+//   much more often than they are changed (see SORTED BAGS below); Item must
+//   then also have a less-than operator (x < y) that is a strict weak order
+//   agreeing with ==. Below, bag<Item> is short for bag<Item, Sorted>.
 // NOTE:
 //   Many compilers require the use of the new keyword typename before using
 //   the expressions bag<Item>::value_type and bag<Item>::size_type. Otherwise
@@ -39,6 +44,13 @@
 //   void operator +=(const bag<Item>& addend)
 //     Postcondition: Each item in addend has been added to this bag.
 //
+//   void seed(std::uint64_t new_seed)
+//     Postcondition: The bag's own pseudorandom generator, used by grab and
+//     grab_n, has been started over with the given seed, so that the items
+//     chosen from then on can be reproduced. (Without a call to seed, a bag's
+//     generator is seeded by fresh_seed( ) from pcg32.h when the bag is
+//     constructed, so each bag gets different numbers.)
+//
 //   void reserve(size_type new_capacity)
 //     Postcondition: The bag's current capacity is changed to new_capacity
 //     (but not less than the number of items currently in the bag). The insert
@@ -51,13 +63,28 @@
 //
 //   Item grab( ) const
 //     Precondition: size( ) > 0
-//     Postcondition: The return value is a randomly selected item from the bag.
+//     Postcondition: The return value is a randomly selected item from the bag,
+//     each copy being equally likely. This takes constant time.
+//
+//   bag<Item> grab_n(size_type k) const
+//     Precondition: k <= size( ).
+//     Postcondition: The bag returned holds k items chosen at random from this
+//     bag without replacement: each set of k of the copies in this bag is
+//     equally likely. This takes time proportional to k, not to size( )
+//     (for a sorted bag, k log k, since the sample is sorted into one run).
 //
 //   size_type size( ) const
 //     Postcondition: The return value is the total number of items in the bag.
 //
+// RANDOM NUMBERS for the bag<Item> template class:
+//   grab and grab_n use a pcg32 generator (see pcg32.h) belonging to the bag,
+//   not std::rand, and the constructors seed it with fresh_seed( ), which is
+//   thread-safe; so bags used by different threads do not share any state.
+//   grab and grab_n change the generator, so two threads that grab from the
+//   same bag at once still need a lock.
+//
 // NONMEMBER FUNCTIONS for the bag<Item> template class:
-//   template <class Item>
+//   template <class Item, bool Sorted>
 //   bag<Item> operator +(const bag<Item>& b1, const bag<Item>& b2)
 //     Postcondition: The bag returned is the union of b1 and b2.
 //
@@ -67,15 +94,43 @@
 // DYNAMIC MEMORY USAGE by the bag<Item> template class: 
 //   If there is insufficient dynamic memory, then the following functions call
 //   new_handler: the constructors, resize, insert, operator += , operator +,
-//   and the assignment operator.
+//   grab_n, and the assignment operator.
+//
+// NUMBERS IN A BAG:
+//   When Item is an arithmetic type (an integer or floating point type),
+//   count and erase look through the unsorted items with vector
+//   instructions, comparing many items at once (see simd_kernels.h). erase
+//   then keeps the other items in their order. Other types of Item use the
+//   plain loops.
+//
+// SORTED BAGS (Sorted is true):
+//   The array holds a few sorted runs of items, followed by an unsorted
+//   run of at most 32 items inserted since. When the unsorted run grows
+//   past 32 items, insert (or operator +=) sorts it into a new sorted run,
+//   and then, for as long as the run before the last is no more than twice
+//   as long as the last, merges those two runs into one (much as the carries
+//   of a binary counter merge equal digits). So each run is more than twice
+//   as long as the next, and there are at most about log2(n) runs; and every
+//   time an item is merged, its run grows by about half, so each item is
+//   moved O(log n) times. Thus insert takes O(log n) time, amortized over a
+//   series of inserts, and the merges use a second array, kept by the bag,
+//   of up to 2n/3 items.
+//   count finds the target in each run by binary search (equal_range) and
+//   looks through the unsorted run only: O(log^2 n) time rather than O(n).
+//   erase and erase_one also search the runs by binary search, but must
+//   still move the items after a removed one down, so they take O(n) time.
+//   (Erasing may leave a run short; it is then merged sooner.)
 
 #ifndef MAIN_SAVITCH_BAG4_H
 #define MAIN_SAVITCH_BAG4_H
+#include <cstdint> // Provides uint64_t
 #include <cstdlib> // Provides size_t
+#include <vector>  // Provides vector
+#include "pcg32.h" // Provides pcg32
 
 namespace main_savitch_6A
 {
-    template <class Item>
+    template <class Item, bool Sorted = false>
     class bag
     {
     public:
@@ -94,19 +149,32 @@ namespace main_savitch_6A
         void operator =(const bag& source);
         void operator +=(const bag& addend);
         void reserve(size_type capacity);
+        void seed(std::uint64_t new_seed) { gen.seed(new_seed); }
         // CONSTANT MEMBER FUNCTIONS
         size_type count(const Item& target) const;
         Item grab( ) const;
+        bag grab_n(size_type k) const;
         size_type size( ) const { return used; }
     private:
+        // HELPER MEMBER FUNCTIONS for a sorted bag
+        void add_run( );
+        void merge_runs(size_type first, size_type middle, size_type last);
+        void drop_empty_runs( );
+
+        static const size_type UNSORTED_LIMIT = 32;
         Item *data;           // Pointer to partially filled dynamic array
         size_type used;       // How much of array is being used
         size_type capacity;   // Current capacity of the bag
+        size_type sorted_used; // Items in the sorted runs (0 unless Sorted)
+        std::vector<size_type> run_ends; // Where each sorted run ends
+        std::vector<Item> scratch;       // Reused by merge_runs
+        mutable main_savitch_random::pcg32 gen; // Used by grab and grab_n
     };
 
     // NONMEMBER FUNCTIONS
-    template <class Item>
-    bag<Item> operator +(const bag<Item>& b1, const bag<Item>& b2);
+    template <class Item, bool Sorted>
+    bag<Item, Sorted> operator +
+        (const bag<Item, Sorted>& b1, const bag<Item, Sorted>& b2);
 }
 
 #include "bag4.template"  // Include the implementation
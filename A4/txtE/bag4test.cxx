@@ -0,0 +1,349 @@
+// FILE: bag4test.cxx
+// A test program for the 4th version of the bag (from bag4.h and
+// bag4.template), with Sorted false and with Sorted true. Random inserts,
+// erases, += and copies are checked against a table of the true counts;
+// a sorted bag is also given items in order, in reverse order and all
+// equal, and has items erased from the middle of its runs, so that runs
+// are merged and left short in many ways. grab_n is checked to return k
+// items of the bag, each about equally likely, and (for a sorted bag) to
+// return a bag whose count still uses the sorted runs: a count of a sample
+// must not compare the target with more than the 32 unsorted items.
+
+#include <cstdlib>    // Provides EXIT_SUCCESS, EXIT_FAILURE, size_t
+#include <iostream>   // Provides cout
+#include <random>     // Provides mt19937
+#include <vector>     // Provides vector
+#include "bag4.h"     // Provides the bag<Item, Sorted> template class
+using namespace std;
+using namespace main_savitch_6A;
+
+// The items are the numbers 0 to VALUES - 1. A vector<size_t> of VALUES
+// counts (a reference) says how many copies of each a bag should hold.
+const int VALUES = 50;
+
+// An item that counts how many times it is compared with ==. (count
+// compares the target with the unsorted items by ==, and searches the
+// sorted runs with < only.)
+struct counted
+{
+    counted(int v = 0) { value = v; }
+    int value;
+    static size_t equal_tests;
+};
+size_t counted::equal_tests = 0;
+bool operator ==(const counted& a, const counted& b)
+    { ++counted::equal_tests; return a.value == b.value; }
+bool operator !=(const counted& a, const counted& b)
+    { return !(a == b); }
+bool operator <(const counted& a, const counted& b)
+    { return a.value < b.value; }
+
+// PROTOTYPES for functions used by this test program:
+template <bool Sorted>
+bool test_random(const char name[ ]);
+// Postcondition: A bag<int, Sorted> has been given many random inserts,
+// erases, erase_ones, +=, copies and assignments, and checked against a
+// reference after every few. name has been printed with the result, and the
+// return value is true if all of the checks passed.
+
+bool test_runs( );
+// Postcondition: Sorted bags have been filled in order, in reverse order
+// and with equal items, and had items erased from their runs and more
+// items inserted, and have been checked after each step. The return
+// value is true if all of the checks passed.
+
+template <bool Sorted>
+bool test_grab_n(const char name[ ]);
+// Postcondition: grab and grab_n have been checked on a bag<int, Sorted>,
+// and name has been printed with the result. The return value is true if
+// all of the checks passed.
+
+template <class Item, bool Sorted>
+bool same(const bag<Item, Sorted>& b, const vector<size_t>& ref,
+          const char message[ ]);
+// Postcondition: The return value is true if b.size( ) is the total of ref
+// and b.count(v) is ref[v] for every value v. Otherwise message has been
+// written to cout.
+
+bool check(bool condition, const char message[ ]);
+// Postcondition: If condition is false, then message has been written to
+// cout. The return value is condition.
+
+
+int main( )
+{
+    bool passed = true;
+
+    passed &= test_random<false>("random changes, unsorted bag");
+    passed &= test_random<true>("random changes, sorted bag");
+    passed &= test_runs( );
+    passed &= test_grab_n<false>("grab_n, unsorted bag");
+    passed &= test_grab_n<true>("grab_n, sorted bag");
+
+    cout << (passed ? "All tests passed." : "SOME TESTS FAILED.") << endl;
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+template <bool Sorted>
+bool test_random(const char name[ ])
+{
+    bag<int, Sorted> b(4);
+    vector<size_t> ref(VALUES, 0);
+    mt19937 gen(3358);
+    bool passed = true;
+    size_t step;
+    size_t removed;
+    int v;
+
+    for (step = 0; step < 4000 && passed; ++step)
+    {
+        v = int(gen( ) % VALUES);
+        switch (gen( ) % 16)
+        {
+        case 0:     // erase every copy
+            removed = b.erase(v);
+            passed &= check(removed == ref[v], "erase returned the wrong "
+                            "number of copies.");
+            ref[v] = 0;
+            break;
+        case 1:     // erase one copy
+        case 2:
+            passed &= check(b.erase_one(v) == (ref[v] > 0),
+                            "erase_one returned the wrong answer.");
+            if (ref[v] > 0)
+                --ref[v];
+            break;
+        case 3:     // += a copy of a few of the items
+            if (step % 4 == 0)
+            {
+                bag<int, Sorted> part(b.grab_n(b.size( ) / 8));
+                for (v = 0; v < VALUES; ++v)
+                    ref[v] += part.count(v);
+                b += part;
+            }
+            break;
+        case 4:     // copy and assign
+            if (step % 8 == 0)
+            {
+                bag<int, Sorted> copy(b);
+                bag<int, Sorted> assigned;
+                assigned.insert(v);
+                assigned = copy;
+                b = assigned;
+            }
+            break;
+        default:    // insert
+            b.insert(v);
+            ++ref[v];
+            break;
+        }
+        if (step % 4 == 0)
+            passed &= same(b, ref, "The bag went wrong after random "
+                           "changes.");
+    }
+
+    // b += b doubles each count.
+    b += b;
+    for (v = 0; v < VALUES; ++v)
+        ref[v] *= 2;
+    passed &= same(b, ref, "b += b did not double the counts.");
+    b = b + b;
+    for (v = 0; v < VALUES; ++v)
+        ref[v] *= 2;
+    passed &= same(b, ref, "b + b did not double the counts.");
+
+    cout << name << ": " << (passed ? "passed" : "FAILED") << endl;
+    return passed;
+}
+
+bool test_runs( )
+{
+    const size_t N = 1000;
+    bool passed = true;
+    size_t order;
+    size_t i;
+    int v;
+
+    for (order = 0; order < 3; ++order)
+    {
+        bag<int, true> b;
+        vector<size_t> ref(VALUES, 0);
+
+        // In order, in reverse order, or all the same.
+        for (i = 0; i < N; ++i)
+        {
+            if (order == 0)
+                v = int(i * VALUES / N);
+            else if (order == 1)
+                v = int(VALUES - 1 - i * VALUES / N);
+            else
+                v = 7;
+            b.insert(v);
+            ++ref[v];
+            if (i % 37 == 0 || i == N - 1)
+                passed &= same(b, ref, "Inserting into a sorted bag went "
+                               "wrong.");
+        }
+
+        // Items erased from the middle of the runs leave short runs (or
+        // empty ones, which are dropped).
+        for (v = 0; v < VALUES; v += 3)
+        {
+            ref[v] -= b.erase_one(v) ? 1 : 0;
+            ref[v] -= b.erase_one(v) ? 1 : 0;
+            passed &= same(b, ref, "erase_one went wrong in a sorted bag.");
+        }
+        for (v = 1; v < VALUES; v += 4)
+        {
+            passed &= check(b.erase(v) == ref[v], "erase returned the wrong "
+                            "number of copies from a sorted bag.");
+            ref[v] = 0;
+            passed &= same(b, ref, "erase went wrong in a sorted bag.");
+        }
+
+        // More items merge with the short runs.
+        for (i = 0; i < N; ++i)
+        {
+            v = int((i * 7) % VALUES);
+            b.insert(v);
+            ++ref[v];
+            if (i % 41 == 0 || i == N - 1)
+                passed &= same(b, ref, "Inserting after erasing went wrong.");
+        }
+
+        // Then every item is erased, one copy at a time.
+        for (v = 0; v < VALUES; ++v)
+            while (ref[v] > 0)
+            {
+                passed &= check(b.erase_one(v), "erase_one did not find an "
+                                "item of a sorted bag.");
+                --ref[v];
+            }
+        passed &= same(b, ref, "A sorted bag was not empty at the end.");
+        b.insert(3);
+        ++ref[3];
+        passed &= same(b, ref, "An emptied sorted bag could not be used.");
+    }
+
+    cout << "sorted runs: " << (passed ? "passed" : "FAILED") << endl;
+    return passed;
+}
+
+template <bool Sorted>
+bool test_grab_n(const char name[ ])
+{
+    const size_t SAMPLES[ ] = { 0, 1, 2, 32, 33, 100, 1000 };
+    const size_t TRIALS = 4000;
+    bag<int, Sorted> b;
+    vector<size_t> ref(VALUES, 0);
+    vector<size_t> chosen(VALUES, 0);
+    bool passed = true;
+    bool within = true;
+    size_t i;
+    size_t s;
+    int v;
+
+    for (i = 0; i < 1000; ++i)
+    {
+        v = int((i * 13) % VALUES);
+        b.insert(v);
+        ++ref[v];
+    }
+    b.seed(2016);
+
+    // Each sample holds k items of the bag, and can be used as a bag.
+    for (s = 0; s < sizeof(SAMPLES) / sizeof(SAMPLES[0]); ++s)
+    {
+        bag<int, Sorted> sample(b.grab_n(SAMPLES[s]));
+        vector<size_t> counts(VALUES, 0);
+        passed &= check(sample.size( ) == SAMPLES[s],
+                        "grab_n(k) did not return k items.");
+        for (v = 0; v < VALUES; ++v)
+        {
+            counts[v] = sample.count(v);
+            passed &= check(counts[v] <= ref[v], "grab_n returned more "
+                            "copies of an item than the bag holds.");
+        }
+        if (SAMPLES[s] == b.size( ))
+            passed &= same(sample, ref, "grab_n(size( )) did not return "
+                           "every item.");
+        for (v = 0; v < 40; ++v)
+        {
+            sample.insert(v % VALUES);
+            ++counts[v % VALUES];
+        }
+        passed &= check(sample.erase_one(0) == (counts[0] > 0),
+                        "erase_one went wrong in a sample.");
+        if (counts[0] > 0)
+            --counts[0];
+        passed &= same(sample, counts, "A sample could not be used as a "
+                       "bag.");
+    }
+
+    // Each item of a bag of distinct items is chosen about k / n of the
+    // time (the bounds are more than 5 standard deviations away).
+    bag<int, Sorted> distinct;
+    for (v = 0; v < VALUES; ++v)
+        distinct.insert(v);
+    distinct.seed(1);
+    for (i = 0; i < TRIALS; ++i)
+    {
+        bag<int, Sorted> sample(distinct.grab_n(10));
+        for (v = 0; v < VALUES; ++v)
+            chosen[v] += sample.count(v);
+    }
+    for (v = 0; v < VALUES; ++v)
+        within &= (chosen[v] > 670 && chosen[v] < 930);
+    passed &= check(within, "grab_n did not choose each item about as "
+                    "often.");
+    for (i = 0; i < 200; ++i)
+    {
+        v = distinct.grab( );
+        passed &= check(v >= 0 && v < VALUES, "grab returned an item that "
+                        "is not in the bag.");
+    }
+
+    // A sample of a sorted bag keeps at most 32 items unsorted, so a count
+    // compares the target by == with only those.
+    bag<counted, Sorted> objects;
+    for (i = 0; i < 2000; ++i)
+        objects.insert(counted(int((i * 13) % VALUES)));
+    objects.seed(7);
+    bag<counted, Sorted> sample(objects.grab_n(1000));
+    counted::equal_tests = 0;
+    passed &= check(sample.count(counted(VALUES)) == 0,
+                    "A sample counted an item that is not in it.");
+    if (Sorted)
+        passed &= check(counted::equal_tests <= 32, "A sample of a sorted "
+                        "bag does not keep its items in sorted runs.");
+    else
+        passed &= check(counted::equal_tests == 1000, "count did not look "
+                        "at every item of an unsorted sample.");
+
+    cout << name << ": " << (passed ? "passed" : "FAILED") << endl;
+    return passed;
+}
+
+template <class Item, bool Sorted>
+bool same(const bag<Item, Sorted>& b, const vector<size_t>& ref,
+          const char message[ ])
+{
+    size_t total = 0;
+    int v;
+
+    for (v = 0; v < VALUES; ++v)
+    {
+        total += ref[v];
+        if (b.count(v) != ref[v])
+            return check(false, message);
+    }
+    return check(b.size( ) == total, message);
+}
+
+bool check(bool condition, const char message[ ])
+{
+    if (!condition)
+        cout << message << endl;
+    return condition;
+}
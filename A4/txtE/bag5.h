@@ -1,6 +1,24 @@
 // FILE: bag5.h (part of the namespace main_savitch_chapter6)
 // TEMPLATE CLASS PROVIDED:
-//   bag<Item> (a collection of items; each item may appear multiple times)
+//   bag<Item, NodeAllocator> (a collection of items; each item may appear
+//   multiple times)
+//
+// The items are kept on an unrolled linked list (see unrolled_node.h): each
+// node holds an array of up to unrolled_node<Item>::CAPACITY items, so count,
+// erase and a walk with the bag's iterators go through arrays of items and
+// follow only one link per node, rather than one per item.
+//
+// TEMPLATE PARAMETERS for the bag class:
+//   Item is the type of the items, as described below. NodeAllocator is the
+//   class that creates and destroys the nodes of the bag's linked list (see
+//   node_pool.h); it must create unrolled_node<Item> objects. By default it
+//   is node_pool<Item, unrolled_node<Item> >: each bag has a pool of its own,
+//   so its nodes are allocated from contiguous blocks, insert and erase reuse
+//   nodes without going to the heap, and the destructor and assignment
+//   operator give back a whole bag by deleting its blocks, rather than
+//   deleting each node. heap_node_allocator<Item, unrolled_node<Item> >
+//   allocates each node with new. Below, bag<Item> is short for
+//   bag<Item, NodeAllocator>.
 //
 // TYPEDEFS for the bag<Item> template class:
 //   bag<Item>::value_type
@@ -17,10 +35,15 @@
 //   bag<Item>::iterator and bag<Item>::const_iterator
 //     Forward iterators for a bag or a const bag.
 //   
-// CONSTRUCTOR for the bag<Item> class:
+// CONSTRUCTORS for the bag<Item> class:
 //   bag( )
 //     Postcondition: The bag is empty.
 //
+//   bag(bag&& source)
+//     Postcondition: The bag holds the items that were in source, whose nodes
+//     (and, for a node_pool, whose memory) it has taken over; source is empty.
+//     This takes constant time and allocates nothing.
+//
 // MODIFICATION MEMBER FUNCTIONS for the bag<Item> class:
 //   size_type erase(const Item& target)
 //     Postcondition: All copies of target have been removed from the bag.
@@ -38,13 +61,42 @@
 //   void operator +=(const bag& addend) 
 //     Postcondition: Each item in addend has been added to this bag.
 //
+//   void operator +=(bag&& addend)
+//     Postcondition: As for splice, except that addend may be this bag (when
+//     its items are copied, as above).
+//
+//   void splice(bag&& addend)
+//     Precondition: addend is not this bag.
+//     Postcondition: The items of addend have been moved to this bag, and
+//     addend is empty. addend's nodes are relinked onto this bag's list (and
+//     this bag's allocator adopts them), so this takes constant time and
+//     allocates nothing, however big the bags are. This is the way to merge
+//     a bag that will not be used again, such as a temporary.
+//
+//   void seed(std::uint64_t new_seed)
+//     Postcondition: The bag's own pseudorandom generator, used by grab and
+//     grab_n, has been started over with the given seed, so that the items
+//     chosen from then on can be reproduced. (Without a call to seed, a bag's
+//     generator is seeded by fresh_seed( ) from pcg32.h when the bag is
+//     constructed, so each bag gets different numbers.)
+//
 // CONSTANT MEMBER FUNCTIONS for the bag<Item> class:
 //   size_type count(const Item& target) const 
 //     Postcondition: Return value is number of times target is in the bag.
 //
 //   Item grab( ) const 
 //     Precondition: size( ) > 0.
-//     Postcondition: The return value is a randomly selected item from the bag.
+//     Postcondition: The return value is a randomly selected item from the bag,
+//     each copy being equally likely. This takes constant time, except that
+//     the first grab after operator += or an assignment (or in a copy) walks
+//     the list once to rebuild the bag's index of its nodes.
+//
+//   bag grab_n(size_type k) const
+//     Precondition: k <= size( ).
+//     Postcondition: The bag returned holds k items chosen at random from this
+//     bag without replacement: each set of k of the copies in this bag is
+//     equally likely. Apart from rebuilding the index as for grab, this takes
+//     time proportional to k, not to size( ).
 //
 //   size_type size( ) const 
 //     Postcondition: Return value is the total number of items in the bag.
@@ -56,38 +108,57 @@
 //   const iterator end( ) const
 //
 // NONMEMBER FUNCTIONS for the bag<Item> class:
-//   template <class Item>
+//   template <class Item, class NodeAllocator>
 //   bag<Item> operator +(const bag<Item>& b1, const bag<Item>& b2) 
 //     Postcondition: The bag returned is the union of b1 and b2.
+//     There are also versions where b1, b2, or both are bag<Item>&&. These
+//     take over the nodes of an rvalue argument, as splice does, and copy only
+//     the items of the other argument (if it is not an rvalue too).
 //
 // VALUE SEMANTICS for the bag<Item> class:
 //    Assignments and the copy constructor may be used with bag objects.
+//    With a node_pool, the copy is made in one block of exactly the right
+//    size (see reserve in node_pool.h), its nodes in list order.
 //
 // DYNAMIC MEMORY USAGE by the bag<Item>: 
 //   If there is insufficient dynamic memory, then the following functions throw
-//   bad_alloc: The constructors, insert, operator +=, operator +, and the
-//   assignment operator.
+//   bad_alloc: The constructors, insert, operator +=, operator +, grab,
+//   grab_n, and the assignment operator.
+//
+// RANDOM NUMBERS for the bag<Item> class:
+//   grab and grab_n use a pcg32 generator (see pcg32.h) belonging to the bag,
+//   not std::rand, and the constructors seed it with fresh_seed( ), which is
+//   thread-safe; so bags used by different threads do not share any state.
+//   grab and grab_n change the generator (and may rebuild the index), so two
+//   threads that grab from the same bag at once still need a lock.
 
 #ifndef MAIN_SAVITCH_BAG5_H
 #define MAIN_SAVITCH_BAG5_H
+#include <cstdint>   // Provides uint64_t
 #include <cstdlib>   // Provides NULL and size_t and NULL
 #include "node2.h"   // Provides node class
+#include "node_pool.h"  // Provides node_pool
+#include "unrolled_node.h"  // Provides unrolled_node and its iterators
+#include "pcg32.h"   // Provides pcg32
+#include <utility>   // Provides move
 
 namespace main_savitch_6B
 {
-    template <class Item>
+    template <class Item,
+              class NodeAllocator = node_pool<Item, unrolled_node<Item> > >
     class bag
     {
     public:
         // TYPEDEFS
 	typedef std::size_t size_type;
         typedef Item value_type;
-	typedef node_iterator<Item> iterator;
-	typedef const_node_iterator<Item> const_iterator;
+	typedef node_iterator<Item, unrolled_node<Item> > iterator;
+	typedef const_node_iterator<Item, unrolled_node<Item> > const_iterator;
 	
         // CONSTRUCTORS and DESTRUCTOR
         bag( );
         bag(const bag& source);
+        bag(bag&& source);
         ~bag( );
 	
         // MODIFICATION MEMBER FUNCTIONS
@@ -95,12 +166,16 @@ namespace main_savitch_6B
         bool erase_one(const Item& target);
         void insert(const Item& entry);
         void operator +=(const bag& addend);
+        void operator +=(bag&& addend);
         void operator =(const bag& source);
+        void splice(bag&& addend);
+        void seed(std::uint64_t new_seed) { gen.seed(new_seed); }
 	
         // CONST MEMBER FUNCTIONS
         size_type count(const Item& target) const;
         Item grab( ) const;
-        size_type size( ) const { return many_nodes; }
+        bag grab_n(size_type k) const;
+        size_type size( ) const { return many_items; }
 	
 	// FUNCTIONS TO PROVIDE ITERATORS
 	iterator begin( )
@@ -113,13 +188,40 @@ namespace main_savitch_6B
 	    { return const_iterator( ); } // Uses default constructor 
 
     private:
-        node<Item> *head_ptr;        // Head pointer for the list of items
+	typedef unrolled_node<Item> unode;
+
+	// HELPER MEMBER FUNCTIONS
+	void remove_at(unode* target_ptr, size_type i);
+	const Item& item_at(size_type i) const;
+	void rebuild_index( ) const;
+
+        unode *head_ptr;             // Head pointer for the list of items
+        unode *tail_ptr;             // Tail pointer for the list
+        size_type many_items;        // Number of items in the bag
         size_type many_nodes;        // Number of nodes on the list
+        NodeAllocator alloc;         // Creates and destroys the nodes
+        mutable unode **node_index;  // The nodes, from the tail to the head
+        mutable size_type index_capacity;  // Size of the node_index array
+        mutable bool index_valid;    // Whether node_index is up to date
+        mutable main_savitch_random::pcg32 gen; // Used by grab and grab_n
     };
 
     // NONMEMBER functions for the bag
-    template <class Item>
-    bag<Item> operator +(const bag<Item>& b1, const bag<Item>& b2);
+    template <class Item, class NodeAllocator>
+    bag<Item, NodeAllocator> operator +
+        (const bag<Item, NodeAllocator>& b1, const bag<Item, NodeAllocator>& b2);
+
+    template <class Item, class NodeAllocator>
+    bag<Item, NodeAllocator> operator +
+        (bag<Item, NodeAllocator>&& b1, const bag<Item, NodeAllocator>& b2);
+
+    template <class Item, class NodeAllocator>
+    bag<Item, NodeAllocator> operator +
+        (const bag<Item, NodeAllocator>& b1, bag<Item, NodeAllocator>&& b2);
+
+    template <class Item, class NodeAllocator>
+    bag<Item, NodeAllocator> operator +
+        (bag<Item, NodeAllocator>&& b1, bag<Item, NodeAllocator>&& b2);
 }
 
 // The implementation of a template class must be included in its header file:
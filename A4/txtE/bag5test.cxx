@@ -0,0 +1,235 @@
+// FILE: bag5test.cxx
+// A test program for the ways that the 5th version of the bag (from bag5.h
+// and bag5.template) takes over the nodes of another bag: splice, operator
+// += and operator + with an rvalue, and the move constructor. The edge
+// cases are tried with bags of several sizes (empty, a partly full head
+// node, exactly one full node, many nodes): splicing an empty bag,
+// splicing into an empty bag, and b += std::move(b). After each one, the
+// sizes and counts must be right, and so must the end of the list: this is
+// checked by splicing more nodes onto the bag and by splicing the bag onto
+// another one, since both follow the tail pointer.
+// Each test is run with a node_pool and with a heap_node_allocator.
+
+#include <cstdlib>    // Provides EXIT_SUCCESS, EXIT_FAILURE, size_t
+#include <iostream>   // Provides cout
+#include <utility>    // Provides move
+#include <vector>     // Provides vector
+#include "bag5.h"     // Provides the bag<Item, NodeAllocator> template class
+using namespace std;
+using namespace main_savitch_6B;
+
+// The items are the numbers 0 to VALUES - 1. A vector<size_t> of VALUES
+// counts (a reference) says how many copies of each a bag should hold.
+const int VALUES = 16;
+const size_t K = unrolled_node<int>::CAPACITY;  // Items per node
+
+// Sizes of the bags that are tried: empty, a partly full head node, one
+// full node, and several nodes with a partly full head.
+const size_t SIZES[ ] = { 0, 1, K - 1, K, K + 1, 3 * K + 2 };
+const size_t MANY_SIZES = sizeof(SIZES) / sizeof(SIZES[0]);
+
+// PROTOTYPES for functions used by this test program:
+template <class Alloc>
+bool test_allocator(const char name[ ]);
+// Postcondition: Every test below has been run with bags whose
+// NodeAllocator is Alloc, and name has been printed with the result. The
+// return value is true if all of them passed.
+
+template <class Alloc>
+void fill(bag<int, Alloc>& b, size_t n, int first, vector<size_t>& ref);
+// Postcondition: n items have been inserted into b (first, first + 1, ...,
+// wrapping around at VALUES), and each has been counted in ref.
+
+template <class Alloc>
+bool same(const bag<int, Alloc>& b, const vector<size_t>& ref,
+          const char message[ ]);
+// Postcondition: The return value is true if b.size( ) is the total of ref,
+// b.count(v) is ref[v] for every value v, and a walk from b.begin( ) to
+// b.end( ) visits exactly b.size( ) items. Otherwise message has been
+// written to cout.
+
+template <class Alloc>
+bool tail_works(bag<int, Alloc>& b, vector<size_t>& ref,
+                const char message[ ]);
+// Precondition: b holds the items counted by ref.
+// Postcondition: A bag of several nodes has been spliced onto b (which
+// links them after b's tail), then b has been spliced onto a bag of a few
+// items (which links b's nodes up to its tail) and copied back. ref has
+// been updated to match, and the return value is true if b was right
+// after each step (as for same). b's size is now more than 3 nodes.
+
+bool check(bool condition, const char message[ ]);
+// Postcondition: If condition is false, then message has been written to
+// cout. The return value is condition.
+
+
+int main( )
+{
+    bool passed = true;
+
+    passed &= test_allocator<node_pool<int, unrolled_node<int> > >
+        ("node_pool");
+    passed &= test_allocator<heap_node_allocator<int, unrolled_node<int> > >
+        ("heap_node_allocator");
+
+    cout << (passed ? "All tests passed." : "SOME TESTS FAILED.") << endl;
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+template <class Alloc>
+bool test_allocator(const char name[ ])
+{
+    bool passed = true;
+    size_t i;
+    size_t j;
+
+    for (i = 0; i < MANY_SIZES; ++i)
+    {
+        vector<size_t> ref(VALUES, 0);
+
+        // Splicing an empty bag changes nothing.
+        bag<int, Alloc> b;
+        bag<int, Alloc> empty;
+        fill(b, SIZES[i], 0, ref);
+        b.splice(std::move(empty));
+        passed &= same(b, ref, "Splicing an empty bag changed the bag.");
+        passed &= check(empty.size( ) == 0 && empty.begin( ) == empty.end( ),
+                        "An empty bag was not empty after a splice.");
+        b += bag<int, Alloc>( );
+        passed &= same(b, ref, "+= an empty rvalue changed the bag.");
+        passed &= tail_works(b, ref, "The tail was lost by splicing an "
+                             "empty bag.");
+
+        // Splicing into an empty bag takes all of the nodes; the bag that
+        // was spliced is left empty, and still usable.
+        vector<size_t> none(VALUES, 0);
+        bag<int, Alloc> into;
+        bag<int, Alloc> source;
+        ref.assign(VALUES, 0);
+        fill(source, SIZES[i], 3, ref);
+        into.splice(std::move(source));
+        passed &= same(into, ref, "Splicing into an empty bag went wrong.");
+        passed &= same(source, none, "A spliced bag was not left empty.");
+        passed &= tail_works(into, ref, "The tail was lost by splicing into "
+                             "an empty bag.");
+        vector<size_t> again(VALUES, 0);
+        fill(source, SIZES[i], 5, again);
+        passed &= tail_works(source, again, "A spliced bag could not be "
+                             "used again.");
+
+        // b += std::move(b) copies the items, so each count doubles.
+        bag<int, Alloc> self;
+        ref.assign(VALUES, 0);
+        fill(self, SIZES[i], 7, ref);
+        self += std::move(self);
+        for (j = 0; j < ref.size( ); ++j)
+            ref[j] *= 2;
+        passed &= same(self, ref, "b += std::move(b) did not double b.");
+        passed &= tail_works(self, ref, "The tail was lost by "
+                             "b += std::move(b).");
+
+        // Splices between bags of every pair of sizes (so that the head
+        // nodes are merged in some, and topped up in others).
+        for (j = 0; j < MANY_SIZES; ++j)
+        {
+            bag<int, Alloc> b1;
+            bag<int, Alloc> b2;
+            ref.assign(VALUES, 0);
+            fill(b1, SIZES[i], 1, ref);
+            fill(b2, SIZES[j], 2, ref);
+            b1.splice(std::move(b2));
+            passed &= same(b1, ref, "Splicing two bags went wrong.");
+            passed &= same(b2, none, "A spliced bag was not left empty.");
+            passed &= tail_works(b1, ref, "The tail was lost by splicing "
+                                 "two bags.");
+        }
+
+        // operator + with one or both arguments rvalues (temporaries).
+        bag<int, Alloc> b3;
+        bag<int, Alloc> b4;
+        vector<size_t> both(VALUES, 0);
+        fill(b3, SIZES[i], 4, both);
+        fill(b4, SIZES[MANY_SIZES - 1 - i], 6, both);
+        ref = both;
+        bag<int, Alloc> sum1(b3 + bag<int, Alloc>(b4));
+        passed &= same(sum1, ref, "b1 + (an rvalue) went wrong.");
+        passed &= tail_works(sum1, ref, "The tail was lost by "
+                             "b1 + (an rvalue).");
+        ref = both;
+        bag<int, Alloc> sum2(bag<int, Alloc>(b3) + b4);
+        passed &= same(sum2, ref, "(an rvalue) + b2 went wrong.");
+        passed &= tail_works(sum2, ref, "The tail was lost by "
+                             "(an rvalue) + b2.");
+        ref = both;
+        bag<int, Alloc> sum3(bag<int, Alloc>(b3) + bag<int, Alloc>(b4));
+        passed &= same(sum3, ref, "(an rvalue) + (an rvalue) went wrong.");
+        passed &= tail_works(sum3, ref, "The tail was lost by "
+                             "(an rvalue) + (an rvalue).");
+    }
+
+    cout << name << ": " << (passed ? "passed" : "FAILED") << endl;
+    return passed;
+}
+
+template <class Alloc>
+void fill(bag<int, Alloc>& b, size_t n, int first, vector<size_t>& ref)
+{
+    size_t i;
+    int v;
+
+    for (i = 0; i < n; ++i)
+    {
+        v = int((first + i) % VALUES);
+        b.insert(v);
+        ++ref[v];
+    }
+}
+
+template <class Alloc>
+bool same(const bag<int, Alloc>& b, const vector<size_t>& ref,
+          const char message[ ])
+{
+    typename bag<int, Alloc>::const_iterator cursor;
+    size_t total = 0;
+    size_t visited = 0;
+    int v;
+
+    for (v = 0; v < VALUES; ++v)
+    {
+        total += ref[v];
+        if (b.count(v) != ref[v])
+            return check(false, message);
+    }
+    // The walk stops one past size( ), in case the list has a loop.
+    for (cursor = b.begin( ); cursor != b.end( ) && visited <= total;
+         ++cursor)
+        ++visited;
+    return check(b.size( ) == total && visited == total, message);
+}
+
+template <class Alloc>
+bool tail_works(bag<int, Alloc>& b, vector<size_t>& ref,
+                const char message[ ])
+{
+    bag<int, Alloc> more;
+    bag<int, Alloc> front;
+    bool passed = true;
+
+    fill(more, 2 * K + 1, 9, ref);
+    b.splice(std::move(more));
+    passed &= same(b, ref, message);
+    fill(front, 1, 11, ref);
+    front.splice(std::move(b));
+    passed &= same(front, ref, message);
+    b = front;
+    passed &= same(b, ref, message);
+    return passed;
+}
+
+bool check(bool condition, const char message[ ])
+{
+    if (!condition)
+        cout << message << endl;
+    return condition;
+}
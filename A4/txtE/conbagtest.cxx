@@ -0,0 +1,219 @@
+// FILE: conbagtest.cxx
+// A test program for the concurrent bag (from concurrent_bag.h and
+// concurrent_bag.template). Producer threads insert items while other
+// threads, at the same time, remove items with erase_one (so that purge
+// and the reclamation of nodes run during the inserts), count items, and
+// visit the bag with for_each. When every thread is done, the size and the
+// count of each item must match what the threads did.
+// Built by "make conbagtest" (or, under ThreadSanitizer, "make tsan").
+// Usage: conbagtest [producers [erasers [items per producer]]]
+
+#include <atomic>     // Provides atomic
+#include <cstdlib>    // Provides EXIT_SUCCESS, EXIT_FAILURE, atoi, exit
+#include <iostream>   // Provides cout
+#include <thread>     // Provides thread, this_thread::yield
+#include <vector>     // Provides vector
+#include "concurrent_bag.h"  // Provides the concurrent bag<Item> class
+using namespace std;
+using namespace main_savitch_6D;
+
+// The items are the numbers 0 to VALUES - 1. Only the even ones are ever
+// removed, so the count of each odd one is known exactly at the end.
+const int VALUES = 64;
+
+// PROTOTYPES for functions used by this test program:
+void produce(bag<int>& b, int items, atomic<size_t> inserted[ ]);
+// Postcondition: items copies of 0, 1, ..., VALUES - 1, in turn, have been
+// inserted into b. After each insert of a value v, inserted[v] was
+// increased by one.
+
+void erase_evens(bag<int>& b, const atomic<bool>& producing,
+                 const atomic<size_t> inserted[ ], atomic<size_t> erased[ ]);
+// Postcondition: Copies of the even values have been removed from b, until
+// producing was false and none was left. A thread first claims a copy of v
+// by increasing erased[v], and only while erased[v] is less than
+// inserted[v]; so every erase_one it calls must find a copy. If one does
+// not, this has been reported on cout and the program has exited with
+// EXIT_FAILURE.
+
+void watch(const bag<int>& b, const atomic<bool>& producing, int producers,
+           int items);
+// Postcondition: count and for_each have been called on b, again and again,
+// until producing was false. Any impossible result (more copies of an item
+// than the producers will ever insert, or more items visited) has been
+// reported on cout and has made the program exit with EXIT_FAILURE.
+
+size_t copies_inserted(int value, int producers, int items);
+// Postcondition: The return value is the number of copies of value that the
+// given number of producers, each inserting items items, insert in all.
+
+bool check(bool condition, const char message[ ]);
+// Postcondition: If condition is false, then message has been written to
+// cout. The return value is condition.
+
+
+int main(int argc, char* argv[ ])
+{
+    int producers = (argc > 1) ? atoi(argv[1]) : 4;
+    int erasers = (argc > 2) ? atoi(argv[2]) : 2;
+    int items = (argc > 3) ? atoi(argv[3]) : 10000;
+    bag<int> b;
+    atomic<bool> producing(true);
+    atomic<size_t> inserted[VALUES];
+    atomic<size_t> erased[VALUES];
+    vector<thread> threads;
+    size_t expected_size;
+    size_t visited;
+    bool passed = true;
+    int v;
+    int i;
+
+    cout << producers << " producers of " << items << " items, "
+         << erasers << " erasers, 2 watchers." << endl;
+    for (v = 0; v < VALUES; ++v)
+    {
+        inserted[v].store(0);
+        erased[v].store(0);
+    }
+
+    for (i = 0; i < erasers; ++i)
+        threads.push_back(thread(erase_evens, ref(b), cref(producing),
+                                 inserted, erased));
+    for (i = 0; i < 2; ++i)
+        threads.push_back(thread(watch, cref(b), cref(producing),
+                                 producers, items));
+    for (i = 0; i < producers; ++i)
+        threads.push_back(thread(produce, ref(b), items, inserted));
+
+    // The producers were started last, so they are the last threads.
+    for (i = 0; i < producers; ++i)
+        threads[erasers + 2 + i].join( );
+    producing.store(false);
+    for (i = 0; i < erasers + 2; ++i)
+        threads[i].join( );
+
+    // Now the bag is quiet, and everything must add up.
+    expected_size = 0;
+    for (v = 0; v < VALUES; ++v)
+    {
+        expected_size += inserted[v].load( ) - erased[v].load( );
+        passed &= check(inserted[v].load( )
+                        == copies_inserted(v, producers, items),
+                        "The producers did not insert every item.");
+        passed &= check(b.count(v) == inserted[v].load( ) - erased[v].load( ),
+                        "A count is not the number inserted less the "
+                        "number erased.");
+    }
+    passed &= check(b.size( ) == expected_size,
+                    "size( ) is not the number inserted less the number "
+                    "erased.");
+    passed &= check((erasers == 0) || (b.count(0) == 0),
+                    "An even item was left after the erasers finished.");
+    visited = 0;
+    b.for_each([&visited](const int&) { ++visited; });
+    passed &= check(visited == expected_size,
+                    "for_each did not visit every item exactly once.");
+
+    // Then every item is removed, by all the threads at once. Each thread
+    // takes its values in turn, so that the copy it looks for is always
+    // near the front of a list.
+    threads.clear( );
+    for (i = 0; i < producers; ++i)
+        threads.push_back(thread([&b, i, producers]
+        {
+            bool removed_any = true;
+            while (removed_any)
+            {
+                removed_any = false;
+                for (int value = i; value < VALUES; value += producers)
+                    removed_any |= b.erase_one(value);
+            }
+        }));
+    for (i = 0; i < producers; ++i)
+        threads[i].join( );
+    passed &= check(b.size( ) == 0, "The bag was not emptied.");
+
+    cout << (passed ? "All tests passed." : "SOME TESTS FAILED.") << endl;
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+void produce(bag<int>& b, int items, atomic<size_t> inserted[ ])
+{
+    int i;
+
+    for (i = 0; i < items; ++i)
+    {
+        b.insert(i % VALUES);
+        ++inserted[i % VALUES];
+    }
+}
+
+void erase_evens(bag<int>& b, const atomic<bool>& producing,
+                 const atomic<size_t> inserted[ ], atomic<size_t> erased[ ])
+{
+    bool was_producing;
+    bool claimed_any;
+    int v;
+
+    do
+    {
+        // Read first: if the producers were done before this pass, a pass
+        // that claims nothing means that nothing is left to claim.
+        was_producing = producing.load( );
+        claimed_any = false;
+        for (v = 0; v < VALUES; v += 2)
+        {
+            if (erased[v].fetch_add(1) >= inserted[v].load( ))
+            {   // Every copy inserted so far is claimed already.
+                --erased[v];
+                continue;
+            }
+            claimed_any = true;
+            if (!b.erase_one(v))
+            {
+                cout << "erase_one did not find a copy known to be there."
+                     << endl;
+                exit(EXIT_FAILURE);
+            }
+        }
+        if (!claimed_any)
+            this_thread::yield( );   // Let the producers catch up
+    }
+    while (was_producing || claimed_any);
+}
+
+void watch(const bag<int>& b, const atomic<bool>& producing, int producers,
+           int items)
+{
+    size_t visited;
+
+    while (producing.load( ))
+    {
+        if (b.count(1) > copies_inserted(1, producers, items))
+        {
+            cout << "count found more copies than were inserted." << endl;
+            exit(EXIT_FAILURE);
+        }
+        visited = 0;
+        b.for_each([&visited](const int&) { ++visited; });
+        if (visited > size_t(producers) * items)
+        {
+            cout << "for_each visited more items than were inserted." << endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+size_t copies_inserted(int value, int producers, int items)
+{
+    return size_t(producers)
+        * (items / VALUES + ((value < items % VALUES) ? 1 : 0));
+}
+
+bool check(bool condition, const char message[ ])
+{
+    if (!condition)
+        cout << message << endl;
+    return condition;
+}
@@ -0,0 +1,146 @@
+// FILE: concurrent_bag.h (part of the namespace main_savitch_6D)
+// TEMPLATE CLASS PROVIDED: bag<Item>
+//   A bag that many threads may use at once, with no lock. It is meant for
+//   the case of many producer threads inserting into one shared bag, which
+//   with bag5.h needs a mutex around every insert.
+//
+//   The items are kept on STRIPES linked lists. Each thread inserts at the
+//   head of a list of its own (threads are given lists in turn), with one
+//   compare-and-swap of that head pointer, as in list_head_insert of node2.h
+//   (this is a Treiber stack push). So producers on different lists never
+//   touch the same memory, and insert throughput grows with the number of
+//   producers, up to STRIPES of them.
+//
+//   erase_one removes an item by marking its node as erased; the marked
+//   nodes are taken off the lists later, by whichever thread is the first to
+//   find enough of them. A node taken off a list is not deleted until every
+//   thread that might still be looking at it is done (epoch-based
+//   reclamation: each search, count or for_each counts itself in for the
+//   current epoch, and nodes taken off during an epoch are deleted only
+//   when no thread remains in that epoch).
+//
+// TEMPLATE PARAMETER and TYPEDEFS for the bag<Item> template class:
+//   Item is the data type of the items in the bag. It may be any of the C++
+//   built-in types (int, char, etc.), or a class with a copy constructor and
+//   a test for equality (x == y). bag<Item>::value_type is Item, and
+//   bag<Item>::size_type is std::size_t.
+//
+// CONSTRUCTOR and DESTRUCTOR for the bag<Item> template class:
+//   bag( )
+//     Postcondition: The bag is empty.
+//
+//   ~bag( )
+//     Precondition: No other thread is using the bag.
+//     Postcondition: Every node of the bag has been deleted.
+//
+// MODIFICATION MEMBER FUNCTIONS for the bag<Item> template class:
+//   (Any of these may be called by many threads at once.)
+//   void insert(const Item& entry)
+//     Postcondition: A new copy of entry has been inserted into the bag. This
+//     never waits for another thread; it retries its compare-and-swap only if
+//     another thread changed the same head pointer at that moment.
+//
+//   bool erase_one(const Item& target)
+//     Postcondition: If target was in the bag, then one copy of target has
+//     been removed from the bag and the return value is true; otherwise the
+//     bag is unchanged and the return value is false. When two threads try
+//     to remove the same copy, only one of them does.
+//
+// CONSTANT MEMBER FUNCTIONS for the bag<Item> template class:
+//   size_type count(const Item& target) const
+//     Postcondition: The return value is the number of copies of target found
+//     in the bag. (Copies inserted or removed during the count may or may not
+//     be counted.)
+//
+//   size_type size( ) const
+//     Postcondition: The return value is the number of items in the bag. If
+//     other threads are inserting or removing items at the same time, this
+//     is approximate: each change is counted as soon as it is seen.
+//
+//   template <class Function>
+//   void for_each(Function f) const
+//     Postcondition: f(item) has been called for each item in the bag (each
+//     copy of each item) that was not removed before the call began. The
+//     items inserted or removed during the call may or may not be visited.
+//     Each item is passed as a const Item&, which stays valid until f
+//     returns.
+//
+// VALUE SEMANTICS for the bag<Item> template class:
+//   Assignments and the copy constructor may NOT be used with bag objects.
+//
+// DYNAMIC MEMORY USAGE by the bag<Item> template class:
+//   If there is insufficient dynamic memory, then insert throws bad_alloc.
+
+#ifndef MAIN_SAVITCH_CONCURRENT_BAG_H
+#define MAIN_SAVITCH_CONCURRENT_BAG_H
+#include <atomic>    // Provides atomic
+#include <cstdlib>   // Provides NULL and size_t
+
+namespace main_savitch_6D
+{
+    template <class Item>
+    class bag
+    {
+    public:
+        // TYPEDEFS and MEMBER CONSTANTS
+	typedef Item value_type;
+	typedef std::size_t size_type;
+	static const size_type STRIPES = 16;
+	static const size_type PURGE_THRESHOLD = 64;
+        // CONSTRUCTOR and DESTRUCTOR
+	bag( );
+	~bag( );
+        // MODIFICATION MEMBER FUNCTIONS
+	void insert(const Item& entry);
+	bool erase_one(const Item& target);
+        // CONSTANT MEMBER FUNCTIONS
+	size_type count(const Item& target) const;
+	size_type size( ) const;
+	template <class Function>
+	void for_each(Function f) const;
+    private:
+	struct cnode
+	{
+	    cnode(const Item& init_data) : data(init_data), erased(false) { }
+	    const Item data;
+	    std::atomic<cnode*> link;
+	    std::atomic<bool> erased;
+	    cnode *next_retired;        // Once taken off its list
+	};
+
+	struct alignas(64) stripe      // Own cache line, so stripes never share
+	{
+	    std::atomic<cnode*> head_ptr;
+	    std::atomic<size_type> many_items;
+	};
+
+	class epoch_guard               // Counts a reader in for its lifetime
+	{
+	public:
+	    epoch_guard(const bag& b);
+	    ~epoch_guard( );
+	private:
+	    const bag& owner;
+	    std::size_t parity;
+	};
+
+	bag(const bag& source) = delete;
+	void operator =(const bag& source) = delete;
+	// HELPER MEMBER FUNCTIONS
+	static size_type my_stripe( );
+	void purge( );
+	bool drained(std::size_t parity) const;
+	static void delete_retired(cnode* retired_ptr);
+
+	stripe stripes[STRIPES];
+	std::atomic<std::size_t> epoch;        // Advanced by each purge
+	mutable std::atomic<size_type> readers[2];  // Count by epoch parity
+	std::atomic<size_type> many_marked;    // Erased but still on a list
+	std::atomic<bool> purging;             // Held by the one purging thread
+	cnode *retired_ptr;                    // Taken off, not yet deleted
+	std::size_t retired_epoch;             // Epoch they were taken off in
+    };
+}
+
+#include "concurrent_bag.template"  // Include the implementation
+#endif
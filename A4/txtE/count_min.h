@@ -0,0 +1,169 @@
+// FILE: count_min.h (part of the namespace main_savitch_6E)
+// TEMPLATE CLASS PROVIDED: count_min_sketch<Item, Hash>
+//   An approximate bag, for streams of items too big to keep in one of the
+//   exact bags (bag4.h, bag5.h, hashbag.h). It has the same insert, count,
+//   size and operator += as those bags, but it does not keep the items:
+//   it keeps depth rows of width counters, and each item adds to one
+//   counter in each row, chosen by hashing. So its memory is fixed when it
+//   is constructed, however many items are inserted; a program may start
+//   with an exact bag and switch to a sketch when memory runs short.
+//
+//   count(x) is the smallest of x's counters, which is never less than the
+//   true number of copies of x. With probability at least 1 - delta, it is
+//   more than that by at most epsilon * size( ). insert uses the
+//   "conservative update" rule (it raises a counter only as far as needed
+//   for the new smallest count), which keeps these guarantees and makes the
+//   counts of rare items more accurate.
+//
+//   The sketch also keeps a fixed number of the items with the largest
+//   counts seen so far, so that it can report the heavy hitters: the items
+//   that make up at least a given fraction of the stream.
+//
+// TEMPLATE PARAMETERS and TYPEDEFS for the count_min_sketch class:
+//   Item is the data type of the items, also defined as
+//   count_min_sketch<Item, Hash>::value_type. It may be any of the C++
+//   built-in types, or a class with a default constructor, an assignment
+//   operator and a test for equality (x == y). Hash is a function object
+//   type whose objects map an Item to a size_t, giving equal values for
+//   equal items (std::hash<Item> by default).
+//   count_min_sketch<Item, Hash>::size_type is the data type of the counts.
+//
+// CONSTRUCTOR for the count_min_sketch<Item, Hash> template class:
+//   count_min_sketch(double epsilon = DEFAULT_EPSILON,
+//                    double delta = DEFAULT_DELTA,
+//                    size_type tracked = DEFAULT_TRACKED)
+//     Precondition: 0 < epsilon < 1 and e^(-32) <= delta < 1 (so that there
+//     are at most 32 rows).
+//     Postcondition: The sketch is empty. It has depth = ceiling(ln(1/delta))
+//     rows of width counters, where width is e / epsilon rounded up to a
+//     power of two, and keeps up to tracked candidate heavy hitters.
+//     Note: If epsilon or delta is out of range (or is a NaN), the
+//     constructor throws std::invalid_argument rather than building a
+//     sketch with more rows than it can hash into. So it does if epsilon
+//     is so small that the table would be bigger than a vector can hold.
+//
+// MODIFICATION MEMBER FUNCTIONS for the count_min_sketch class:
+//   void insert(const Item& entry, size_type many = 1)
+//     Postcondition: many new copies of entry have been counted. This takes
+//     time proportional to depth + tracked, and allocates no memory.
+//
+//   void operator +=(const count_min_sketch& addend)
+//     Precondition: addend has the same width and depth as this sketch (for
+//     example, it was built with the same epsilon and delta).
+//     Postcondition: This sketch now counts the items of both sketches, as
+//     if they had all been inserted here.
+//     Note: If addend's width or depth is different, this throws
+//     std::invalid_argument and the sketch is unchanged.
+//
+//   void clear( )
+//     Postcondition: The sketch is empty again (with the same size).
+//
+// CONSTANT MEMBER FUNCTIONS for the count_min_sketch class:
+//   size_type count(const Item& target) const
+//     Postcondition: The return value is an estimate of the number of copies
+//     of target counted, as described above (never too small).
+//
+//   size_type size( ) const
+//     Postcondition: The return value is the total number of copies of all
+//     items counted (exactly).
+//
+//   bool is_heavy(const Item& target, double phi) const
+//     Precondition: 0 < phi <= 1.
+//     Postcondition: The return value is true if count(target) is at least
+//     phi * size( ). Every item that truly makes up a fraction phi of the
+//     stream is flagged, and (with probability at least 1 - delta) no item
+//     that makes up less than phi - epsilon of it.
+//
+//   std::vector<Item> heavy_hitters(double phi) const
+//     Precondition: 0 < phi <= 1.
+//     Postcondition: The return value holds the tracked candidates for which
+//     is_heavy(item, phi) is true, most frequent first. If tracked is at
+//     least 1 / phi, every item that truly makes up a fraction phi of the
+//     stream is usually among them (the candidates are the items with the
+//     largest counts seen when they were inserted).
+//
+//   std::size_t width( ) const and std::size_t depth( ) const
+//     Postcondition: The return values are the size of the counter table.
+//
+// NONMEMBER FUNCTIONS for the count_min_sketch<Item, Hash> class:
+//   template <class Item, class Hash>
+//   count_min_sketch<Item, Hash> operator +
+//     (const count_min_sketch<Item, Hash>& s1,
+//      const count_min_sketch<Item, Hash>& s2)
+//     Precondition: s1 and s2 have the same width and depth.
+//     Postcondition: The sketch returned counts the items of both.
+//     (Throws std::invalid_argument, as += does, if they do not.)
+//
+// VALUE SEMANTICS for the count_min_sketch<Item, Hash> class:
+//   Assignments and the copy constructor may be used with sketch objects.
+//
+// DYNAMIC MEMORY USAGE by the count_min_sketch<Item, Hash> class:
+//   If there is insufficient dynamic memory, then the following functions
+//   throw bad_alloc: the constructors, operator +, heavy_hitters, and the
+//   assignment operator. (The constructor, operator += and operator + also
+//   throw invalid_argument, as described above.)
+
+#ifndef MAIN_SAVITCH_COUNT_MIN_H
+#define MAIN_SAVITCH_COUNT_MIN_H
+#include <cstdint>     // Provides uint64_t
+#include <cstdlib>     // Provides size_t
+#include <functional>  // Provides hash
+#include <vector>      // Provides vector
+
+namespace main_savitch_6E
+{
+    template <class Item, class Hash = std::hash<Item> >
+    class count_min_sketch
+    {
+    public:
+        // TYPEDEFS and MEMBER CONSTANTS
+	typedef Item value_type;
+	typedef std::size_t size_type;
+	static constexpr double DEFAULT_EPSILON = 0.001;
+	static constexpr double DEFAULT_DELTA = 0.01;
+	static const size_type DEFAULT_TRACKED = 16;
+        // CONSTRUCTOR
+	count_min_sketch(double epsilon = DEFAULT_EPSILON,
+	                 double delta = DEFAULT_DELTA,
+	                 size_type tracked = DEFAULT_TRACKED);
+        // MODIFICATION MEMBER FUNCTIONS
+	void insert(const Item& entry, size_type many = 1);
+	void operator +=(const count_min_sketch& addend);
+	void clear( );
+        // CONSTANT MEMBER FUNCTIONS
+	size_type count(const Item& target) const;
+	size_type size( ) const { return total; }
+	bool is_heavy(const Item& target, double phi) const;
+	std::vector<Item> heavy_hitters(double phi) const;
+	std::size_t width( ) const { return many_columns; }
+	std::size_t depth( ) const { return many_rows; }
+    private:
+	struct candidate
+	{
+	    Item data;
+	    size_type estimate;    // count(data) when last looked at
+	};
+
+	// HELPER MEMBER FUNCTIONS
+	void columns(const Item& target, std::size_t answer[ ]) const;
+	void track(const Item& entry, size_type estimate);
+
+	static const std::size_t MAX_ROWS = 32;
+	std::vector<size_type> table;   // Row r is table[r*width( )] onward
+	std::size_t many_columns;       // A power of two
+	std::size_t many_rows;
+	size_type total;                // Copies counted
+	std::vector<candidate> candidates;  // The first many_candidates are used
+	size_type many_candidates;
+	Hash hasher;
+    };
+
+    // NONMEMBER FUNCTIONS
+    template <class Item, class Hash>
+    count_min_sketch<Item, Hash> operator +
+        (const count_min_sketch<Item, Hash>& s1,
+	 const count_min_sketch<Item, Hash>& s2);
+}
+
+#include "count_min.template"  // Include the implementation
+#endif
@@ -0,0 +1,137 @@
+// FILE: hashbag.h (part of the namespace main_savitch_6C)
+// TEMPLATE CLASS PROVIDED: bag<Item, Hash>
+//   A bag with the same interface as bag4.h, but which stores each
+//   distinct item only once, together with its multiplicity (the number of
+//   copies in the bag), in an open-address hash table. count, erase,
+//   erase_one and insert then take expected constant time, instead of a
+//   scan of the whole bag. size( ) is still the total number of copies.
+//
+// TEMPLATE PARAMETERS, TYPEDEFS and MEMBER CONSTANTS for the bag class:
+//   Item is the data type of the items in the bag, also defined as
+//   bag<Item, Hash>::value_type. It may be any of the C++ built-in types, or
+//   a class with a default constructor, an assignment operator, and
+//   operators to test for equality (x == y) and non-equality (x != y).
+//   Hash is a function object type whose objects map an Item to a size_t,
+//   giving equal values for equal items (std::hash<Item> by default).
+//   bag<Item, Hash>::size_type is the data type of any variable that keeps
+//   track of how many items are in a bag. DEFAULT_CAPACITY is the number
+//   of distinct items that a bag created by the default constructor can
+//   hold before its table must grow.
+//
+// CONSTRUCTOR for the bag<Item, Hash> template class:
+//   bag(size_type initial_capacity = DEFAULT_CAPACITY)
+//     Postcondition: The bag is empty. insert will not allocate new memory
+//     until initial_capacity distinct items are in the bag.
+//
+// MODIFICATION MEMBER FUNCTIONS for the bag<Item, Hash> template class:
+//   size_type erase(const Item& target)
+//   bool erase_one(const Item& target)
+//   void insert(const Item& entry)
+//   void operator +=(const bag& addend)
+//     Postcondition: As for bag4.h. operator += adds each distinct item of
+//     addend once, with its multiplicity.
+//
+//   void reserve(size_type new_capacity)
+//     Postcondition: insert will not allocate new memory until new_capacity
+//     distinct items are in the bag.
+//
+//   void seed(std::uint64_t new_seed)
+//     Postcondition: As for bag4.h: the bag's own generator, used by grab,
+//     has been started over with the given seed.
+//
+// CONSTANT MEMBER FUNCTIONS for the bag<Item, Hash> template class:
+//   size_type count(const Item& target) const
+//   size_type size( ) const
+//     Postcondition: As for bag4.h.
+//
+//   size_type distinct( ) const
+//     Postcondition: The return value is the number of different items in
+//     the bag.
+//
+//   Item grab( ) const
+//     Precondition: size( ) > 0.
+//     Postcondition: The return value is a randomly selected item from the
+//     bag, each copy being equally likely (so an item is chosen with
+//     probability count(item) / size( )). This walks the table, so it is
+//     linear in the table size rather than constant time. As in bag4.h,
+//     the number is drawn from a pcg32 generator belonging to the bag,
+//     seeded by fresh_seed( ) when the bag is constructed, not std::rand.
+//
+// NONMEMBER FUNCTIONS for the bag<Item, Hash> template class:
+//   template <class Item, class Hash>
+//   bag<Item, Hash> operator +(const bag<Item, Hash>& b1,
+//                              const bag<Item, Hash>& b2)
+//     Postcondition: The bag returned is the union of b1 and b2.
+//
+// VALUE SEMANTICS for the bag<Item, Hash> template class:
+//   Assignments and the copy constructor may be used with bag objects.
+//
+// DYNAMIC MEMORY USAGE by the bag<Item, Hash> template class:
+//   If there is insufficient dynamic memory, then the following functions
+//   throw bad_alloc: the constructors, reserve, insert, operator +=,
+//   operator +, and the assignment operator.
+
+#ifndef MAIN_SAVITCH_HASHBAG_H
+#define MAIN_SAVITCH_HASHBAG_H
+#include <cstdint>     // Provides uint64_t
+#include <cstdlib>     // Provides size_t
+#include <functional>  // Provides hash
+#include "pcg32.h"     // Provides pcg32
+
+namespace main_savitch_6C
+{
+    template <class Item, class Hash = std::hash<Item> >
+    class bag
+    {
+    public:
+        // TYPEDEFS and MEMBER CONSTANTS
+	typedef Item value_type;
+	typedef std::size_t size_type;
+	static const size_type DEFAULT_CAPACITY = 30;
+        // CONSTRUCTORS and DESTRUCTOR
+        bag(size_type initial_capacity = DEFAULT_CAPACITY);
+        bag(const bag& source);
+        ~bag( );
+        // MODIFICATION MEMBER FUNCTIONS
+        size_type erase(const Item& target);
+        bool erase_one(const Item& target);
+        void insert(const Item& entry);
+        void operator =(const bag& source);
+        void operator +=(const bag& addend);
+        void reserve(size_type new_capacity);
+        void seed(std::uint64_t new_seed) { gen.seed(new_seed); }
+        // CONSTANT MEMBER FUNCTIONS
+        size_type count(const Item& target) const;
+        Item grab( ) const;
+        size_type size( ) const { return used; }
+        size_type distinct( ) const { return many_distinct; }
+    private:
+        struct cell
+        {
+            Item data;           // The item
+            size_type many;      // Its multiplicity; 0 marks an empty slot
+        };
+
+        // HELPER MEMBER FUNCTIONS
+        size_type home(const Item& target) const;
+        size_type find(const Item& target) const;
+        void add(const Item& entry, size_type many);
+        void remove_slot(size_type slot);
+        void rehash(size_type new_slots);
+
+        cell *table;               // Open-address hash table
+        size_type slots;           // Size of table (a power of two)
+        size_type used;            // Total number of copies in the bag
+        size_type many_distinct;   // Number of slots in use
+        Hash hasher;
+        mutable main_savitch_random::pcg32 gen; // Used by grab
+    };
+
+    // NONMEMBER FUNCTIONS
+    template <class Item, class Hash>
+    bag<Item, Hash> operator +(const bag<Item, Hash>& b1,
+                               const bag<Item, Hash>& b2);
+}
+
+#include "hashbag.template"  // Include the implementation
+#endif
@@ -0,0 +1,366 @@
+// FILE: hashbagtest.cxx
+// A test program for the hash table bag (from hashbag.h and
+// hashbag.template). Random inserts, erases, += and copies are checked
+// against a table of the true counts, both with std::hash and with hash
+// functions that put many items in the same probe run, so that erasing
+// must shift later items of a run back (across the end of the table, too).
+// The table is also made to grow many times, a bag is added to itself, and
+// grab is checked to choose each copy about equally often, from a
+// generator that seed makes repeatable.
+
+#include <cstdlib>     // Provides EXIT_SUCCESS, EXIT_FAILURE, size_t
+#include <iostream>    // Provides cout
+#include <random>      // Provides mt19937
+#include <vector>      // Provides vector
+#include "hashbag.h"   // Provides the bag<Item, Hash> template class
+using namespace std;
+using namespace main_savitch_6C;
+
+// The items of the random tests are the numbers 0 to VALUES - 1. A
+// vector<size_t> of VALUES counts (a reference) says how many copies of
+// each a bag should hold.
+const int VALUES = 200;
+
+// Hash functions that give many items the same hash value. same_hash gives
+// every item the value collide_with, which a test sets before it makes a
+// bag (and leaves alone while the bag is used); quarter_hash gives the
+// same value to each group of four numbers.
+size_t collide_with = 0;
+struct same_hash
+{
+    size_t operator ( )(int) const { return collide_with; }
+};
+struct quarter_hash
+{
+    size_t operator ( )(int v) const { return size_t(v / 4); }
+};
+
+// PROTOTYPES for functions used by this test program:
+template <class Hash>
+bool test_random(const char name[ ]);
+// Postcondition: A bag<int, Hash> has been given many random inserts,
+// erases, erase_ones, +=, copies and assignments, and checked against a
+// reference after every few. name has been printed with the result, and the
+// return value is true if all of the checks passed.
+
+bool test_runs( );
+// Postcondition: Full tables of 8 slots, whose items all have the same
+// home slot (for each of 64 hash values, so that the run often wraps past
+// the end of the table), have had their items erased in several orders,
+// and have been checked after each erase. The return value is true if all
+// of the checks passed.
+
+bool test_growth( );
+// Postcondition: A bag has grown from the smallest table to one of many
+// thousands of items, and been reserved, copied and added to itself, with
+// checks after each step. The return value is true if all passed.
+
+bool test_grab( );
+// Postcondition: grab has been checked to return items of the bag, each
+// copy about equally often, and to repeat its choices after seed. The
+// return value is true if all of the checks passed.
+
+template <class Hash>
+bool same(const bag<int, Hash>& b, const vector<size_t>& ref,
+          const char message[ ]);
+// Postcondition: The return value is true if b.size( ) is the total of ref,
+// b.distinct( ) is the number of nonzero entries of ref and b.count(v) is
+// ref[v] for every v < ref.size( ). Otherwise message has been written to
+// cout.
+
+bool check(bool condition, const char message[ ]);
+// Postcondition: If condition is false, then message has been written to
+// cout. The return value is condition.
+
+
+int main( )
+{
+    bool passed = true;
+
+    passed &= test_random< hash<int> >("random changes, std::hash");
+    passed &= test_random<quarter_hash>("random changes, 4 items a hash");
+    passed &= test_runs( );
+    passed &= test_growth( );
+    passed &= test_grab( );
+
+    cout << (passed ? "All tests passed." : "SOME TESTS FAILED.") << endl;
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+template <class Hash>
+bool test_random(const char name[ ])
+{
+    bag<int, Hash> b(4);
+    bag<int, Hash> other;
+    vector<size_t> ref(VALUES, 0);
+    vector<size_t> other_ref(VALUES, 0);
+    mt19937 gen(3358);
+    bool passed = true;
+    size_t step;
+    size_t removed;
+    int v;
+    int w;
+
+    for (step = 0; step < 20000 && passed; ++step)
+    {
+        v = int(gen( ) % VALUES);
+        switch (gen( ) % 16)
+        {
+        case 0:     // erase every copy
+        case 1:
+            removed = b.erase(v);
+            passed &= check(removed == ref[v], "erase returned the wrong "
+                            "number of copies.");
+            ref[v] = 0;
+            break;
+        case 2:     // erase one copy
+        case 3:
+        case 4:
+            passed &= check(b.erase_one(v) == (ref[v] > 0),
+                            "erase_one returned the wrong answer.");
+            if (ref[v] > 0)
+                --ref[v];
+            break;
+        case 5:     // += another bag
+            if (step % 16 == 0)
+            {
+                b += other;
+                for (w = 0; w < VALUES; ++w)
+                    ref[w] += other_ref[w];
+            }
+            other.insert(v);
+            ++other_ref[v];
+            break;
+        case 6:     // copy and assign
+            if (step % 16 == 0)
+            {
+                bag<int, Hash> copy(b);
+                bag<int, Hash> assigned;
+                assigned.insert(v);
+                assigned = copy;
+                copy.insert(v);
+                b = assigned;
+            }
+            break;
+        default:    // insert
+            b.insert(v);
+            ++ref[v];
+            break;
+        }
+        if (step % 8 == 0)
+            passed &= same(b, ref, "The bag went wrong after random "
+                           "changes.");
+    }
+    passed &= same(other, other_ref, "The bag added with += changed.");
+
+    cout << name << ": " << (passed ? "passed" : "FAILED") << endl;
+    return passed;
+}
+
+bool test_runs( )
+{
+    // Orders in which to erase the six items 0 to 5 of a run.
+    const int ORDERS[ ][6] = { { 0, 1, 2, 3, 4, 5 }, { 5, 4, 3, 2, 1, 0 },
+                               { 2, 3, 1, 4, 0, 5 }, { 1, 3, 5, 0, 2, 4 } };
+    const size_t MANY_ORDERS = sizeof(ORDERS) / sizeof(ORDERS[0]);
+    bool passed = true;
+    size_t order;
+    size_t i;
+    int v;
+
+    for (collide_with = 0; collide_with < 64; ++collide_with)
+        for (order = 0; order < MANY_ORDERS; ++order)
+        {
+            // Six items fill 3/4 of the 8 slots, all in one run.
+            bag<int, same_hash> b(6);
+            vector<size_t> ref(6, 0);
+            for (v = 0; v < 6; ++v)
+            {
+                b.insert(v);
+                b.insert(v);
+                ref[v] = 2;
+            }
+            passed &= same(b, ref, "A run of colliding items went wrong.");
+
+            // Erasing one copy leaves the item in the run; erasing the last
+            // copy empties its slot, and the later items must move back.
+            for (i = 0; i < 6; ++i)
+            {
+                v = ORDERS[order][i];
+                passed &= check(b.erase_one(v), "erase_one did not find an "
+                                "item of a run.");
+                --ref[v];
+                passed &= same(b, ref, "erase_one went wrong in a run.");
+                if (i % 2 == 0)
+                {
+                    passed &= check(b.erase_one(v), "erase_one did not find "
+                                    "an item of a run.");
+                    --ref[v];
+                }
+                else
+                {
+                    passed &= check(b.erase(v) == 1, "erase returned the "
+                                    "wrong number of copies from a run.");
+                    ref[v] = 0;
+                }
+                passed &= same(b, ref, "Erasing from a run went wrong.");
+                passed &= check(!b.erase_one(v) && b.erase(v) == 0,
+                                "An erased item was still found.");
+            }
+
+            // The emptied table can be filled again.
+            for (v = 0; v < 6; ++v)
+            {
+                b.insert(5 - v);
+                ++ref[5 - v];
+            }
+            passed &= same(b, ref, "A run could not be refilled.");
+        }
+
+    cout << "probe runs: " << (passed ? "passed" : "FAILED") << endl;
+    return passed;
+}
+
+bool test_growth( )
+{
+    const int MANY = 20000;
+    bag< int, hash<int> > b;
+    vector<size_t> ref(MANY, 0);
+    bool passed = true;
+    int v;
+
+    // Each item is inserted (v % 3) + 1 times. The table doubles each time
+    // it would be more than 3/4 full.
+    for (v = 0; v < MANY; ++v)
+    {
+        b.insert(v);
+        ++ref[v];
+        if (v % 3 > 0)
+        {
+            b.insert(v);
+            ++ref[v];
+        }
+        if (v % 3 > 1)
+        {
+            b.insert(v);
+            ++ref[v];
+        }
+        if ((v & (v - 1)) == 0 || v == MANY - 1)
+            passed &= same(b, ref, "The bag went wrong as its table grew.");
+    }
+
+    // reserve with more room, and with less (which does nothing).
+    b.reserve(4 * MANY);
+    passed &= same(b, ref, "reserve lost items.");
+    b.reserve(10);
+    passed &= same(b, ref, "reserve of less room lost items.");
+
+    // A copy is separate from the original.
+    bag< int, hash<int> > copy(b);
+    copy.erase(0);
+    copy.insert(MANY + 1);
+    passed &= same(b, ref, "Changing a copy changed the original.");
+
+    // b += b and b + b double every count; += of an empty bag, or of b to
+    // an empty bag, changes nothing.
+    b += b;
+    for (v = 0; v < MANY; ++v)
+        ref[v] *= 2;
+    passed &= same(b, ref, "b += b did not double the counts.");
+    b = b + b;
+    for (v = 0; v < MANY; ++v)
+        ref[v] *= 2;
+    passed &= same(b, ref, "b + b did not double the counts.");
+    bag< int, hash<int> > empty;
+    b += empty;
+    empty += b;
+    passed &= same(b, ref, "b += an empty bag changed b.");
+    passed &= same(empty, ref, "An empty bag += b is not a copy of b.");
+
+    // Then the items are erased, half at a time, and the rest checked.
+    for (v = 0; v < MANY; v += 2)
+    {
+        passed &= check(b.erase(v) == ref[v], "erase returned the wrong "
+                        "number of copies.");
+        ref[v] = 0;
+    }
+    passed &= same(b, ref, "Erasing half of the items went wrong.");
+
+    cout << "growth and +=: " << (passed ? "passed" : "FAILED") << endl;
+    return passed;
+}
+
+bool test_grab( )
+{
+    const size_t TRIALS = 40000;
+    bag< int, hash<int> > b;
+    bag< int, hash<int> > twin;
+    vector<size_t> chosen(4, 0);
+    bool passed = true;
+    bool within = true;
+    bool repeated = true;
+    bool differed = false;
+    size_t i;
+    int v;
+
+    // Item v has v + 1 copies, so it is chosen (v + 1) / 10 of the time
+    // (the bounds are more than 5 standard deviations away).
+    for (v = 0; v < 4; ++v)
+        for (i = 0; i <= size_t(v); ++i)
+            b.insert(v);
+    b.seed(1);
+    for (i = 0; i < TRIALS; ++i)
+    {
+        v = b.grab( );
+        if (check(v >= 0 && v < 4, "grab returned an item not in the bag."))
+            ++chosen[v];
+        else
+            passed = false;
+    }
+    for (v = 0; v < 4; ++v)
+        within &= (chosen[v] > (v + 1) * TRIALS / 10 - 500
+                   && chosen[v] < (v + 1) * TRIALS / 10 + 500);
+    passed &= check(within, "grab did not choose each copy about as often.");
+
+    // Two bags with the same seed make the same choices; a copy has a
+    // generator of its own, seeded differently.
+    twin = b;
+    b.seed(2016);
+    twin.seed(2016);
+    for (i = 0; i < 1000; ++i)
+        repeated &= (b.grab( ) == twin.grab( ));
+    passed &= check(repeated, "Bags with the same seed chose differently.");
+    bag< int, hash<int> > copy(b);
+    for (i = 0; i < 1000; ++i)
+        differed |= (b.grab( ) != copy.grab( ));
+    passed &= check(differed, "A copy shares its generator's sequence.");
+
+    cout << "grab: " << (passed ? "passed" : "FAILED") << endl;
+    return passed;
+}
+
+template <class Hash>
+bool same(const bag<int, Hash>& b, const vector<size_t>& ref,
+          const char message[ ])
+{
+    size_t total = 0;
+    size_t distinct = 0;
+    size_t v;
+
+    for (v = 0; v < ref.size( ); ++v)
+    {
+        total += ref[v];
+        distinct += (ref[v] > 0);
+        if (b.count(int(v)) != ref[v])
+            return check(false, message);
+    }
+    return check(b.size( ) == total && b.distinct( ) == distinct, message);
+}
+
+bool check(bool condition, const char message[ ])
+{
+    if (!condition)
+        cout << message << endl;
+    return condition;
+}
@@ -0,0 +1,105 @@
+// FILE: listbench.cxx
+// A timing program for the batched searches of node2.h.
+// The nodes are linked in a random order, so that following a link is a
+// jump to an unrelated address, and there are enough of them (by default)
+// to fill more memory than the last-level cache of most machines. Every
+// search is for a target that is not on the list, so every node is visited.
+// Usage: listbench [number of nodes]
+
+#include <algorithm>  // Provides shuffle
+#include <chrono>     // Provides steady_clock
+#include <cstdlib>    // Provides EXIT_SUCCESS, atol, size_t
+#include <iostream>   // Provides cout
+#include <random>     // Provides mt19937
+#include <vector>     // Provides vector
+#include "node2.h"    // Provides node and the linked list toolkit
+using namespace std;
+using namespace main_savitch_6B;
+
+// PROTOTYPES for functions used by this timing program:
+template <class Item>
+node<Item>* link_randomly(vector< node<Item> >& nodes, size_t lists,
+                          vector< node<Item>* >& heads);
+// Postcondition: The nodes have been linked, in a random order, into the
+// given number of lists of (nearly) equal length, whose head pointers are in
+// heads. The return value is heads[0].
+
+double milliseconds_since(chrono::steady_clock::time_point start);
+// Postcondition: The return value is the time since start, in milliseconds.
+
+
+int main(int argc, char* argv[ ])
+{
+    const size_t LISTS = 64;    // For the batched searches
+    size_t many = (argc > 1) ? size_t(atol(argv[1])) : (size_t(1) << 23);
+    chrono::steady_clock::time_point start;
+    size_t i;
+
+    cout << "Searching " << many << " nodes linked in random order.\n";
+
+    // The nodes as LISTS lists, searched one at a time and then
+    // SEARCH_GROUP at a time.
+    {
+	vector< node<int> > nodes(many);
+	vector< node<int>* > heads;
+	vector<int> targets(LISTS, -1);
+	vector< node<int>* > answers(LISTS);
+
+	link_randomly(nodes, LISTS, heads);
+	start = chrono::steady_clock::now( );
+	for (i = 0; i < LISTS; ++i)
+	    answers[i] = list_search(heads[i], targets[i]);
+	cout << LISTS << " x list_search:  " << milliseconds_since(start)
+	     << " ms\n";
+	for (i = 0; i < LISTS; ++i)
+	    if (answers[i] != NULL)
+		return EXIT_FAILURE;
+
+	start = chrono::steady_clock::now( );
+	list_search_many(&heads[0], &targets[0], LISTS, &answers[0]);
+	cout << "list_search_many: " << milliseconds_since(start) << " ms\n";
+	for (i = 0; i < LISTS; ++i)
+	    if (answers[i] != NULL)
+		return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+template <class Item>
+node<Item>* link_randomly(vector< node<Item> >& nodes, size_t lists,
+                          vector< node<Item>* >& heads)
+// Library facilities used: algorithm, random, vector
+{
+    vector<size_t> order(nodes.size( ));
+    mt19937 engine(2016);
+    size_t per_list = nodes.size( ) / lists;
+    size_t i;
+
+    if (per_list == 0)
+	per_list = 1;  // Fewer nodes than lists: some lists stay empty.
+
+    for (i = 0; i < order.size( ); ++i)
+	order[i] = i;
+    shuffle(order.begin( ), order.end( ), engine);
+
+    heads.assign(lists, NULL);
+    for (i = 0; i < order.size( ); ++i)
+    {
+	// Node order[i] goes at the end of list i / per_list (the last list
+	// takes any extra), before node order[i + 1] of the same list.
+	bool last_of_list = (i + 1 == order.size( ))
+	    || ((i + 1) % per_list == 0 && (i + 1) / per_list < lists);
+	nodes[order[i]].set_link(last_of_list ? NULL : &nodes[order[i + 1]]);
+	if (i % per_list == 0 && i / per_list < lists)
+	    heads[i / per_list] = &nodes[order[i]];
+    }
+    return heads[0];
+}
+
+double milliseconds_since(chrono::steady_clock::time_point start)
+// Library facilities used: chrono
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now( ) - start)
+	.count( );
+}
@@ -7,7 +7,9 @@
 // to the specified node in a linked list, and (2) a default constructor that
 // creates a special iterator that marks the position that is beyond the end of a
 // linked list. There is also a const_node_iterator for use with
-// const node<Item>* .
+// const node<Item>* . (The second template parameter of both iterators is the
+// node type, node<Item> by default; unrolled_node.h specializes them to step
+// through unrolled lists.)
 //
 // TYPEDEF for the node<Item> template class:
 //   Each node of the list contains a piece of data and a pointer to the
@@ -136,14 +138,65 @@
 //     node containing the specified target in its data member. If there is no
 //     such node, the null pointer is returned.
 //
+// BATCHED SEARCHES:
+//   A walk down a linked list waits on each link( ) for a memory load, since
+//   the address of a node is not known until the node before it has been
+//   read. Once a list no longer fits in the cache, that wait is most of the
+//   time taken, and prefetching within the one list cannot help, as nothing
+//   can be fetched before its address is known. Searches of different lists
+//   are independent, though, so their loads can be waited on together.
+//
+//   template <class NodePtr, class Item>
+//   void list_search_many(const NodePtr head_ptrs[ ], const Item targets[ ],
+//                         std::size_t many, NodePtr answers[ ])
+//   The NodePtr may be either node<Item>* or const node<Item>*
+//     Precondition: head_ptrs, targets and answers are arrays of at least
+//     many elements, and each head_ptrs[i] is the head pointer of a linked
+//     list.
+//     Postcondition: For each i, answers[i] is list_search(head_ptrs[i],
+//     targets[i]). The searches are made SEARCH_GROUP at a time, each taking
+//     one step in turn (with a prefetch of its next node), so that the loads
+//     of up to SEARCH_GROUP different lists are waited on together rather
+//     than one after another.
+//
+// FUNCTIONS in the linked list toolkit that take a node allocator:
+//   template <class Item, class NodeAllocator>
+//   void list_clear(node<Item>*& head_ptr, NodeAllocator& alloc)
+//   void list_copy(const node<Item>* source_ptr, node<Item>*& head_ptr,
+//                  node<Item>*& tail_ptr, NodeAllocator& alloc)
+//   void list_head_insert(node<Item>*& head_ptr, const Item& entry,
+//                         NodeAllocator& alloc)
+//   void list_head_remove(node<Item>*& head_ptr, NodeAllocator& alloc)
+//   void list_insert(node<Item>* previous_ptr, const Item& entry,
+//                    NodeAllocator& alloc)
+//   void list_remove(node<Item>* previous_ptr, NodeAllocator& alloc)
+//     Pre- and Postconditions: As for the versions above, except that new
+//     nodes are obtained from alloc.create, and nodes are given back with
+//     alloc.destroy rather than returned to the heap. Every node of the
+//     list must have been created by alloc. (See node_pool.h for the
+//     requirements on a NodeAllocator, and for the allocators provided.)
+//
+//   template <class Item, class NodeAllocator>
+//   void list_copy(const node<Item>* source_ptr, std::size_t many,
+//                  node<Item>*& head_ptr, node<Item>*& tail_ptr,
+//                  NodeAllocator& alloc)
+//     Precondition: source_ptr is the head pointer of a linked list of many
+//     nodes.
+//     Postcondition: As for list_copy above, but alloc.reserve(many) is
+//     called first. With a node_pool, the copy then lies in one contiguous
+//     block in list order, so that a walk down it reads memory straight
+//     through, and if it is destroyed with the pool's other nodes, the block
+//     goes back to the heap in one piece.
+//
 // DYNAMIC MEMORY usage by the toolkit: 
 //   If there is insufficient dynamic memory, then the following functions throw
 //   bad_alloc: the constructor, list_head_insert, list_insert, list_copy.
 
 #ifndef MAIN_SAVITCH_NODE2_H  
 #define MAIN_SAVITCH_NODE2_H
+#include <cstddef>   // Provides ptrdiff_t
 #include <cstdlib>   // Provides NULL and size_t
-#include <iterator>  // Provides iterator and forward_iterator_tag
+#include <iterator>  // Provides forward_iterator_tag
 
 namespace main_savitch_6B
 {
@@ -198,21 +251,70 @@ namespace main_savitch_6B
     template <class NodePtr, class Item>
     NodePtr list_search(NodePtr head_ptr, const Item& target);
 
+    // BATCHED SEARCHES:
+    const std::size_t SEARCH_GROUP = 16;
+
+    inline void prefetch_node(const void* p)
+    {   // A hint only; it never faults, even for NULL.
+#if defined(__GNUC__) || defined(__clang__)
+	__builtin_prefetch(p);
+#else
+	(void) p;
+#endif
+    }
+
+    template <class NodePtr, class Item>
+    void list_search_many
+        (const NodePtr head_ptrs[ ], const Item targets[ ], std::size_t many,
+	 NodePtr answers[ ]);
+
+    // FUNCTIONS to manipulate a linked list whose nodes come from alloc:
+    template <class Item, class NodeAllocator>
+    void list_clear(node<Item>*& head_ptr, NodeAllocator& alloc);
+
+    template <class Item, class NodeAllocator>
+    void list_copy
+        (const node<Item>* source_ptr, node<Item>*& head_ptr, node<Item>*& tail_ptr,
+	 NodeAllocator& alloc);
+
+    template <class Item, class NodeAllocator>
+    void list_copy
+        (const node<Item>* source_ptr, std::size_t many, node<Item>*& head_ptr,
+	 node<Item>*& tail_ptr, NodeAllocator& alloc);
+
+    template <class Item, class NodeAllocator>
+    void list_head_insert
+        (node<Item>*& head_ptr, const Item& entry, NodeAllocator& alloc);
+
+    template <class Item, class NodeAllocator>
+    void list_head_remove(node<Item>*& head_ptr, NodeAllocator& alloc);
+
+    template <class Item, class NodeAllocator>
+    void list_insert
+        (node<Item>* previous_ptr, const Item& entry, NodeAllocator& alloc);
+
+    template <class Item, class NodeAllocator>
+    void list_remove(node<Item>* previous_ptr, NodeAllocator& alloc);
+
     // FORWARD ITERATORS to step through the nodes of a linked list
     // A node_iterator of can change the underlying linked list through the
     // * operator, so it may not be used with a const node. The
     // node_const_iterator cannot change the underlying linked list
     // through the * operator, so it may be used with a const node.
-    // WARNING:
-    // This classes use std::iterator as its base class;
-    // Older compilers that do not support the std::iterator class can
-    // delete everything after the word iterator in the second line:
+    // The five typedefs that std::iterator_traits looks for are declared in
+    // each class (std::iterator, once used as a base for this, is
+    // deprecated in C++17).
 
-    template <class Item>
+    template <class Item, class Node = node<Item> >
     class node_iterator
-    : public std::iterator<std::forward_iterator_tag, Item>
     {
     public:
+	// TYPEDEFS for std::iterator_traits
+	typedef std::forward_iterator_tag iterator_category;
+	typedef Item value_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef Item* pointer;
+	typedef Item& reference;
     	node_iterator(node<Item>* initial = NULL)
 	    { current = initial; }
 	Item& operator *( ) const
@@ -236,11 +338,16 @@ namespace main_savitch_6B
 	node<Item>* current;
     };
 
-    template <class Item>
+    template <class Item, class Node = node<Item> >
     class const_node_iterator
-    : public std::iterator<std::forward_iterator_tag, const Item>
     {
     public:
+	// TYPEDEFS for std::iterator_traits
+	typedef std::forward_iterator_tag iterator_category;
+	typedef Item value_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef const Item* pointer;
+	typedef const Item& reference;
     	const_node_iterator(const node<Item>* initial = NULL)
 	    { current = initial; }
 	const Item& operator *( ) const
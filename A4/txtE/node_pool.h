@@ -0,0 +1,160 @@
+// FILE: node_pool.h (part of the namespace main_savitch_6B)
+// PROVIDES: Two node allocators, for the node<Item> template class of node2.h
+// or for the unrolled_node<Item, K> template class of unrolled_node.h.
+// A node allocator is passed to the list toolkit functions that take one
+// (see node2.h) and is the second template parameter of bag<Item> in bag5.h.
+//
+// TEMPLATE PARAMETERS for both allocator classes:
+//   Item is the type of the data in each node, and Node is the type of node
+//   created (node<Item> by default). Node must have a constructor taking an
+//   Item and a Node* (as node and unrolled_node do). Below, node<Item> stands
+//   for Node.
+//
+// REQUIREMENTS for a node allocator class A (both classes below meet them):
+//   node<Item>* create(const Item& init_data, node<Item>* init_link)
+//     Postcondition: The return value points to a new node containing the
+//     specified data and link.
+//
+//   void destroy(node<Item>* p)
+//     Precondition: p was returned by create on this allocator, and has not
+//     been destroyed since.
+//     Postcondition: The node has been destroyed and its memory given back.
+//
+//   void destroy_list(node<Item>*& head_ptr, std::size_t many)
+//     Precondition: head_ptr is the head pointer of a linked list of many
+//     nodes, each created by this allocator.
+//     Postcondition: Every node of the list has been destroyed, and head_ptr
+//     is NULL.
+//
+//   void reserve(std::size_t many)
+//     Postcondition: The allocator has been told that the next many nodes
+//     will be created together, as by a copy of a list of many nodes, and it
+//     may set aside room for them. (This is only a hint; see below.)
+//
+//   void adopt(A& other)
+//     Postcondition: Every node created by other and not yet destroyed now
+//     belongs to this allocator, which may destroy it; other holds no nodes.
+//     This takes constant time and allocates nothing.
+//
+//   Copying an allocator gives one that may be used for new nodes; nodes
+//   must always be destroyed by the allocator that created (or adopted) them.
+//
+// TEMPLATE CLASS PROVIDED: heap_node_allocator<Item, Node>
+//   Creates each node with new and destroys it with delete, exactly as the
+//   toolkit functions without an allocator parameter do. reserve does
+//   nothing.
+//
+// TEMPLATE CLASS PROVIDED: node_pool<Item, Node>
+//   A slab allocator. Nodes are carved, in order, out of blocks of
+//   block_nodes contiguous nodes, so that the nodes of a list built by
+//   repeated insertion lie next to one another in memory. A destroyed node
+//   goes onto a free list and is reused by the next create, so after the
+//   first blocks are obtained, create and destroy never call new or delete.
+//   When destroy_list is given every node the pool has handed out, the
+//   whole pool is emptied at once by deleting its blocks, without visiting
+//   the nodes at all if Node has a trivial destructor. Memory is only given
+//   back to the heap in that case, and by the destructor. A node_pool is
+//   meant to belong to one bag (or one thread); it is not safe to share one
+//   between threads without a lock. adopt links the other pool's blocks and
+//   free list onto this pool's; the never-used slots at the end of the other
+//   pool's newest block are not reused, but go back with the blocks.
+//   reserve(many) makes sure that the newest block has many never-used
+//   slots, adding a block of max(many, block_nodes) nodes if it has not,
+//   and the next many nodes are then taken from those slots in order even
+//   if the free list is not empty. So a list copied into an empty pool (as
+//   in a bag's copy constructor or assignment) lies in one block, its nodes
+//   one after another in list order, and when the list is destroyed, that
+//   one block is deleted.
+//
+// CONSTRUCTORS and DESTRUCTOR for the node_pool<Item, Node> class:
+//   node_pool(std::size_t block_nodes = DEFAULT_BLOCK_NODES)
+//     Precondition: block_nodes > 0.
+//     Postcondition: The pool is empty. Its first block is obtained by the
+//     first create.
+//
+//   node_pool(const node_pool& source)
+//     Postcondition: The pool is empty, with the block size of source. (The
+//     nodes of source are not copied; they still belong to source.)
+//
+//   ~node_pool( )
+//     Precondition: Every node created by the pool has been destroyed, or
+//     Node has a trivial destructor.
+//     Postcondition: All of the pool's blocks have been deleted.
+//
+// CONSTANT MEMBER FUNCTIONS for the node_pool<Item, Node> class:
+//   std::size_t live( ) const
+//     Postcondition: The return value is the number of nodes created and not
+//     yet destroyed.
+//
+//   std::size_t blocks( ) const
+//     Postcondition: The return value is the number of blocks held.
+//
+// DYNAMIC MEMORY USAGE by the node allocators:
+//   If there is insufficient dynamic memory, then create throws bad_alloc.
+
+#ifndef MAIN_SAVITCH_NODE_POOL_H
+#define MAIN_SAVITCH_NODE_POOL_H
+#include <cstdlib>   // Provides NULL and size_t
+#include "node2.h"   // Provides node
+
+namespace main_savitch_6B
+{
+    template <class Item, class Node = node<Item> >
+    class heap_node_allocator
+    {
+    public:
+	Node* create(const Item& init_data, Node* init_link)
+	    { return new Node(init_data, init_link); }
+	void destroy(Node* p)
+	    { delete p; }
+	void destroy_list(Node*& head_ptr, std::size_t many);
+	void reserve(std::size_t) { }
+	void adopt(heap_node_allocator&) { }
+    };
+
+    template <class Item, class Node = node<Item> >
+    class node_pool
+    {
+    public:
+        // MEMBER CONSTANTS
+	static const std::size_t DEFAULT_BLOCK_NODES = 256;
+        // CONSTRUCTORS and DESTRUCTOR
+	node_pool(std::size_t block_nodes = DEFAULT_BLOCK_NODES);
+	node_pool(const node_pool& source);
+	~node_pool( );
+        // MODIFICATION MEMBER FUNCTIONS
+	Node* create(const Item& init_data, Node* init_link);
+	void destroy(Node* p);
+	void destroy_list(Node*& head_ptr, std::size_t many);
+	void reserve(std::size_t many);
+	void adopt(node_pool& other);
+        // CONST MEMBER FUNCTIONS
+	std::size_t live( ) const { return many_live; }
+	std::size_t blocks( ) const { return many_blocks; }
+    private:
+	union slot
+	{
+	    slot *next_free;     // While the slot is on the free list
+	    alignas(Node) unsigned char bytes[sizeof(Node)];
+	};
+
+	void operator =(const node_pool& source) = delete;
+	// HELPER MEMBER FUNCTIONS
+	void add_block(std::size_t new_block_nodes);
+	void release_blocks( );
+
+	slot *block_list;          // Newest block; slot 0 links to the next
+	slot *oldest_block;        // Last block on that list
+	slot *free_list;           // Destroyed slots, ready for reuse
+	slot *free_tail;           // Last slot on the free list
+	std::size_t next_unused;   // Next never-used slot of the newest block
+	std::size_t newest_nodes;  // Nodes in the newest block
+	std::size_t many_reserved; // Creates still to use never-used slots
+	std::size_t block_nodes;   // Nodes per block (unless reserved)
+	std::size_t many_live;     // Nodes created and not destroyed
+	std::size_t many_blocks;   // Blocks held
+    };
+}
+
+#include "node_pool.template"  // Include the implementation
+#endif
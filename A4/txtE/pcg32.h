@@ -0,0 +1,174 @@
+// FILE: pcg32.h (part of the namespace main_savitch_random)
+// CLASS PROVIDED: pcg32 (a small, fast pseudorandom number generator)
+//   pcg32 is the PCG-XSH-RR generator of M. E. O'Neill: 64 bits of state, a
+//   64-bit stream selector, and 32-bit results. Unlike std::rand, each
+//   pcg32 object has a state of its own, so generators used by different
+//   threads never interfere, and a generator started with the same seed and
+//   stream always gives the same sequence. The bags of bag4.h and bag5.h
+//   each own one, for grab and grab_n. pcg32 meets the requirements of a
+//   uniform random bit generator, so it may also be used with <random>.
+//
+// TYPEDEF for the pcg32 class:
+//   pcg32::result_type is std::uint32_t, the type of the numbers generated.
+//
+// CONSTRUCTOR for the pcg32 class:
+//   pcg32(std::uint64_t init_seed = 0, std::uint64_t stream = 0)
+//     Postcondition: The generator has been seeded, as by seed(init_seed,
+//     stream).
+//
+// MODIFICATION MEMBER FUNCTIONS for the pcg32 class:
+//   void seed(std::uint64_t new_seed, std::uint64_t stream = 0)
+//     Postcondition: The generator starts over with the given seed. Generators
+//     with different streams give unrelated sequences, even for equal seeds.
+//
+//   result_type operator ( )( )
+//     Postcondition: The return value is the next number of the sequence,
+//     between min( ) and max( ).
+//
+//   std::size_t below(std::size_t bound)
+//     Precondition: bound > 0.
+//     Postcondition: The return value is a number from 0 to bound - 1, each
+//     equally likely (there is no bias from taking a remainder).
+//
+//   template <class OutputIterator>
+//   void sample(std::size_t n, std::size_t k, OutputIterator out)
+//     Precondition: k <= n.
+//     Postcondition: k different numbers from 0 to n - 1 have been written to
+//     out, in no particular order. Each set of k numbers is equally likely.
+//     This uses Floyd's algorithm, taking about k steps however large n is.
+//
+// CONSTANT MEMBER FUNCTIONS for the pcg32 class:
+//   static result_type min( ) and static result_type max( )
+//     Postcondition: The return values are 0 and 2^32 - 1.
+//
+// NONMEMBER FUNCTION in the main_savitch_random namespace:
+//   std::uint64_t fresh_seed( )
+//     Postcondition: The return value is a seed for a new generator, which
+//     differs from one call to the next and from one run of the program to
+//     the next. Unlike seeding from std::rand( ), it is safe to call from
+//     many threads at once.
+//
+// DYNAMIC MEMORY USAGE by the pcg32 class:
+//   If there is insufficient dynamic memory, then sample throws bad_alloc.
+
+#ifndef MAIN_SAVITCH_PCG32_H
+#define MAIN_SAVITCH_PCG32_H
+#include <atomic>         // Provides atomic
+#include <cstdint>        // Provides uint32_t and uint64_t
+#include <cstdlib>        // Provides size_t
+#include <random>         // Provides random_device
+#include <unordered_set>  // Provides unordered_set
+
+namespace main_savitch_random
+{
+    class pcg32
+    {
+    public:
+        // TYPEDEF
+	typedef std::uint32_t result_type;
+        // CONSTRUCTOR
+	pcg32(std::uint64_t init_seed = 0, std::uint64_t stream = 0)
+	    { seed(init_seed, stream); }
+        // MODIFICATION MEMBER FUNCTIONS
+	void seed(std::uint64_t new_seed, std::uint64_t stream = 0)
+	    {
+		state = 0;
+		increment = (stream << 1) | 1;   // Must be odd
+		(*this)( );
+		state += new_seed;
+		(*this)( );
+	    }
+	result_type operator ( )( )
+	    {
+		std::uint64_t old_state = state;
+		result_type xorshifted;
+		unsigned rotation;
+
+		state = old_state * 6364136223846793005ull + increment;
+		xorshifted = result_type(((old_state >> 18) ^ old_state) >> 27);
+		rotation = unsigned(old_state >> 59);
+		return (xorshifted >> rotation)
+		    | (xorshifted << ((32 - rotation) & 31));
+	    }
+	std::size_t below(std::size_t bound);
+	template <class OutputIterator>
+	void sample(std::size_t n, std::size_t k, OutputIterator out);
+        // CONSTANT MEMBER FUNCTIONS
+	static constexpr result_type min( ) { return 0; }
+	static constexpr result_type max( ) { return 0xFFFFFFFFu; }
+    private:
+	std::uint64_t state;       // Advanced by each number generated
+	std::uint64_t increment;   // Odd; selects the stream
+    };
+
+    inline std::size_t pcg32::below(std::size_t bound)
+    {
+	std::uint64_t product;
+	std::uint64_t r;
+	std::uint32_t threshold;
+
+	if (std::uint64_t(bound) <= 0xFFFFFFFFull)
+	{   // Lemire's method: the high word of a 32 x 32-bit product, redrawn
+	    // in the rare case that the low word lands in the biased range.
+	    product = std::uint64_t((*this)( )) * bound;
+	    if (std::uint32_t(product) < bound)
+	    {
+		threshold = std::uint32_t(0 - std::uint32_t(bound))
+		    % std::uint32_t(bound);
+		while (std::uint32_t(product) < threshold)
+		    product = std::uint64_t((*this)( )) * bound;
+	    }
+	    return std::size_t(product >> 32);
+	}
+
+	// A bound beyond 32 bits takes two numbers and a remainder, rejecting
+	// the values below 2^64 mod bound so that no remainder is favored.
+	do
+	    r = (std::uint64_t((*this)( )) << 32) | (*this)( );
+	while (r < (0 - std::uint64_t(bound)) % bound);
+	return std::size_t(r % bound);
+    }
+
+    template <class OutputIterator>
+    void pcg32::sample(std::size_t n, std::size_t k, OutputIterator out)
+    // Library facilities used: unordered_set
+    {
+	std::unordered_set<std::size_t> chosen;
+	std::size_t j;
+	std::size_t t;
+
+	// Floyd's algorithm: after the step for j, chosen is a uniformly
+	// random set of the right size drawn from 0 through j.
+	chosen.reserve(k);
+	for (j = n - k; j < n; ++j)
+	{
+	    t = below(j + 1);
+	    if (!chosen.insert(t).second)
+	    {
+		chosen.insert(j);
+		t = j;
+	    }
+	    *out = t;
+	    ++out;
+	}
+    }
+
+    inline std::uint64_t fresh_seed( )
+    // Library facilities used: atomic, cstdint, random
+    {
+	// The counter starts from the system's random device (once: a local
+	// static is initialized only once, even with many threads), and each
+	// call takes a step of it for its own. The finalizer of splitmix64
+	// then spreads the steps over all 64 bits.
+	static std::atomic<std::uint64_t> counter
+	    {std::uint64_t(std::random_device{ }( )) << 32};
+	std::uint64_t z = counter.fetch_add
+	    (0x9E3779B97F4A7C15ull, std::memory_order_relaxed);
+
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+    }
+}
+
+#endif
@@ -0,0 +1,76 @@
+// FILE: simd_kernels.h (part of the namespace main_savitch_6A)
+// PROVIDES: Two array functions for the bag of bag4.h, for use when the
+// items are of an arithmetic type (an integer or floating point type). They
+// compare many items with one vector instruction: 64 bytes at a time on a
+// processor with AVX-512 (the F and BW parts), 32 bytes at a time on one
+// with AVX2, and otherwise by loops without branches, which the compiler may
+// vectorize itself. The processor is asked which it has the first time a
+// function is called, so the same program runs the widest kernels each
+// machine has. The vector kernels are compiled with the target attribute of
+// g++ and clang++, so the program does not need -mavx2 or -march=native;
+// with other compilers, or on other processors, only the loops are used.
+//
+// TYPES AND FUNCTIONS PROVIDED:
+//   enum simd_level { SIMD_SCALAR, SIMD_AVX2, SIMD_AVX512 }
+//     The kinds of kernels, from the narrowest to the widest.
+//
+//   simd_level simd_supported( )
+//     Postcondition: The return value is the widest kind of kernels that
+//     this processor can run (and that this compiler was able to build).
+//
+//   void set_simd_limit(simd_level limit)
+//     Postcondition: count_equal and remove_equal use kernels no wider than
+//     limit (and no wider than simd_supported( )). The limit is SIMD_AVX512
+//     until this is called. It is meant for testing each kind of kernel on
+//     one machine, and must not be called while another thread may be in
+//     count_equal or remove_equal.
+//
+//   template <class Item>
+//   std::size_t count_equal(const Item data[ ], std::size_t n, Item target)
+//     Precondition: Item is an arithmetic type, and data has at least n
+//     items.
+//     Postcondition: The return value is the number of i < n for which
+//     data[i] == target (so a NaN is never counted).
+//
+//   template <class Item>
+//   std::size_t remove_equal(Item data[ ], std::size_t n, Item target)
+//     Precondition: Item is an arithmetic type, and data has at least n
+//     items.
+//     Postcondition: The items of data[0] through data[n - 1] that are not
+//     equal to target have been moved to the front of the array, in their
+//     original order, and the return value is how many there are. The items
+//     after them are unspecified. (With AVX-512, the moving is done by the
+//     compress instruction; with AVX2, by a permutation looked up in a
+//     table.)
+
+#ifndef MAIN_SAVITCH_SIMD_KERNELS_H
+#define MAIN_SAVITCH_SIMD_KERNELS_H
+#include <cstdint>      // Provides int32_t
+#include <cstdlib>      // Provides size_t
+#include <type_traits>  // Provides is_arithmetic, is_floating_point, is_same
+#if (defined(__GNUC__) || defined(__clang__)) \
+    && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>  // Provides the AVX2 and AVX-512 intrinsics
+#define MAIN_SAVITCH_SIMD_DISPATCH 1
+#define MAIN_SAVITCH_TARGET_AVX2 __attribute__((target("avx2")))
+#define MAIN_SAVITCH_TARGET_AVX512 \
+    __attribute__((target("avx512f,avx512bw")))
+#endif
+
+namespace main_savitch_6A
+{
+    enum simd_level { SIMD_SCALAR, SIMD_AVX2, SIMD_AVX512 };
+
+    inline simd_level simd_supported( );
+
+    inline void set_simd_limit(simd_level limit);
+
+    template <class Item>
+    std::size_t count_equal(const Item data[ ], std::size_t n, Item target);
+
+    template <class Item>
+    std::size_t remove_equal(Item data[ ], std::size_t n, Item target);
+}
+
+#include "simd_kernels.template"  // Include the implementation
+#endif
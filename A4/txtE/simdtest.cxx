@@ -0,0 +1,190 @@
+// FILE: simdtest.cxx
+// A test program for count_equal and remove_equal (from simd_kernels.h and
+// simd_kernels.template). Random arrays of each arithmetic type are checked
+// against plain one-item-at-a-time loops, for every length from 0 to a few
+// vectors (so that every length of leftover tail is tried) and some longer
+// ones. The floating point arrays also hold NaN, infinities, 0.0 and -0.0,
+// and NaN, 0.0 and -0.0 are among the targets.
+// The kernels are chosen when the program runs, so it is run once for each
+// kind the processor supports (with set_simd_limit): the AVX-512 kernels,
+// the AVX2 compare and shuffle-table kernels, and the scalar loops. "make
+// simd" also builds it with -march=native, where the compiler may
+// vectorize the loops itself.
+
+#include <cmath>      // Provides NAN, INFINITY
+#include <cstdint>    // Provides int8_t, int16_t, int32_t, int64_t
+#include <cstdlib>    // Provides EXIT_SUCCESS, EXIT_FAILURE, size_t
+#include <cstring>    // Provides memcmp
+#include <iostream>   // Provides cout
+#include <random>     // Provides mt19937
+#include <type_traits>  // Provides is_floating_point
+#include <vector>     // Provides vector
+#include "simd_kernels.h"  // Provides count_equal, remove_equal, simd_level
+using namespace std;
+using namespace main_savitch_6A;
+
+// PROTOTYPES for functions used by this test program:
+template <class Item>
+bool test_type(const char name[ ], mt19937& gen);
+// Postcondition: count_equal and remove_equal have been checked on many
+// random arrays of Item. Each disagreement with the reference loops has
+// been reported on cout (up to a few), and the return value is true if
+// there were none.
+
+template <class Item>
+Item random_item(mt19937& gen);
+// Postcondition: The return value is one of a small set of values of Item,
+// so that equal items are common. For a floating point Item, the set also
+// has NaN, infinity, -infinity, 0.0 and -0.0.
+
+template <class Item>
+bool same_items(const Item a[ ], const Item b[ ], size_t n);
+// Postcondition: The return value is true if a[0] through a[n - 1] have the
+// same bits as b[0] through b[n - 1] (so a NaN matches the same NaN, and
+// 0.0 does not match -0.0).
+
+bool test_level(simd_level level);
+// Postcondition: The kernels have been limited to level, and every type has
+// been tested with them. The return value is true if all of them passed.
+
+
+int main( )
+{
+    const char* NAMES[ ] = { "scalar", "AVX2", "AVX-512" };
+    bool passed = true;
+    int level;
+
+    cout << "This processor supports the " << NAMES[simd_supported( )]
+         << " kernels." << endl;
+    for (level = simd_supported( ); level >= SIMD_SCALAR; --level)
+    {
+        cout << "Testing the " << NAMES[level] << " kernels." << endl;
+        passed &= test_level(simd_level(level));
+    }
+
+    cout << (passed ? "All tests passed." : "SOME TESTS FAILED.") << endl;
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+bool test_level(simd_level level)
+{
+    mt19937 gen(2016);
+    bool passed = true;
+
+    set_simd_limit(level);
+    passed &= test_type<int8_t>("int8_t", gen);
+    passed &= test_type<int16_t>("int16_t", gen);
+    passed &= test_type<int32_t>("int32_t", gen);
+    passed &= test_type<int64_t>("int64_t", gen);
+    passed &= test_type<float>("float", gen);
+    passed &= test_type<double>("double", gen);
+    return passed;
+}
+
+template <class Item>
+bool test_type(const char name[ ], mt19937& gen)
+{
+    // Every length up to four 64-byte vectors, then a few long ones.
+    const size_t SHORT = 4 * 64 / sizeof(Item) + 1;
+    const size_t LONG[ ] = { 1000, 4097 };
+    const size_t TRIALS = 20;   // Random arrays for each length
+    vector<size_t> lengths;
+    vector<Item> data;
+    vector<Item> expected;
+    Item targets[5];
+    size_t failures = 0;
+    size_t n;
+    size_t kept;
+    size_t answer;
+    size_t i;
+    size_t t;
+    size_t trial;
+    size_t k;
+
+    for (n = 0; n <= SHORT; ++n)
+        lengths.push_back(n);
+    for (n = 0; n < sizeof(LONG) / sizeof(LONG[0]); ++n)
+        lengths.push_back(LONG[n]);
+
+    for (k = 0; k < lengths.size( ); ++k)
+        for (trial = 0; trial < TRIALS; ++trial)
+        {
+            n = lengths[k];
+            data.resize(n);
+            for (i = 0; i < n; ++i)
+                data[i] = random_item<Item>(gen);
+
+            // An item of the array (if any), a random value and zero; then
+            // NaN (never equal to anything) and -0.0 (equal to 0.0), or for
+            // integers two more random values.
+            targets[0] = (n > 0) ? data[gen( ) % n] : Item(1);
+            targets[1] = random_item<Item>(gen);
+            targets[2] = Item(0);
+            if constexpr (is_floating_point<Item>::value)
+            {
+                targets[3] = Item(NAN);
+                targets[4] = Item(-0.0);
+            }
+            else
+            {
+                targets[3] = random_item<Item>(gen);
+                targets[4] = random_item<Item>(gen);
+            }
+
+            for (t = 0; t < 5; ++t)
+            {
+                // The reference loops.
+                answer = 0;
+                expected.clear( );
+                for (i = 0; i < n; ++i)
+                    if (data[i] == targets[t])
+                        ++answer;
+                    else
+                        expected.push_back(data[i]);
+
+                if (count_equal(data.data( ), n, targets[t]) != answer)
+                    if (++failures <= 5)
+                        cout << name << ": count_equal is wrong for n = "
+                             << n << endl;
+
+                kept = remove_equal(data.data( ), n, targets[t]);
+                if (kept != expected.size( )
+                    || !same_items(data.data( ), expected.data( ), kept))
+                    if (++failures <= 5)
+                        cout << name << ": remove_equal is wrong for n = "
+                             << n << endl;
+
+                // The next target is looked for in the compacted array.
+                n = kept;
+            }
+        }
+
+    cout << name << ": " << (failures == 0 ? "passed" : "FAILED") << endl;
+    return failures == 0;
+}
+
+template <class Item>
+Item random_item(mt19937& gen)
+{
+    const unsigned VALUES = 8;
+    unsigned r = gen( ) % (VALUES + 5);
+
+    if constexpr (is_floating_point<Item>::value)
+        switch (r)
+        {
+            case VALUES:     return Item(NAN);
+            case VALUES + 1: return Item(INFINITY);
+            case VALUES + 2: return Item(-INFINITY);
+            case VALUES + 3: return Item(-0.0);
+            case VALUES + 4: return Item(0.0);
+            default:         return Item(r) - Item(3.5);
+        }
+    return Item(r % VALUES) - Item(3);
+}
+
+template <class Item>
+bool same_items(const Item a[ ], const Item b[ ], size_t n)
+{
+    return (n == 0) || (memcmp(a, b, n * sizeof(Item)) == 0);
+}
@@ -0,0 +1,295 @@
+// FILE: sketchtest.cxx
+// A test program for the count-min sketch (from count_min.h and
+// count_min.template). It checks the size of the table chosen for several
+// epsilons and deltas (and that values out of range are refused), that
+// count never undercounts and only rarely overcounts by more than
+// epsilon * size( ), that operator + and += count the items of both
+// sketches (and refuse sketches of different shapes), and that
+// heavy_hitters finds the frequent items of a skewed stream.
+
+#include <cmath>      // Provides ceil, exp, log, NAN
+#include <cstdlib>    // Provides EXIT_SUCCESS, EXIT_FAILURE, size_t
+#include <iostream>   // Provides cout
+#include <random>     // Provides mt19937
+#include <stdexcept>  // Provides invalid_argument
+#include <vector>     // Provides vector
+#include "count_min.h"  // Provides the count_min_sketch template class
+using namespace std;
+using namespace main_savitch_6E;
+
+typedef count_min_sketch<int> sketch;
+
+// The streams are of the numbers 0 to VALUES - 1. Item 0 makes up a
+// fraction 0.3 of a skewed stream, item 1 makes up 0.2 and item 2 makes up
+// 0.1; the rest is spread over the other values.
+const int VALUES = 20000;
+const double SHARES[ ] = { 0.3, 0.2, 0.1 };
+const int MANY_SHARES = sizeof(SHARES) / sizeof(SHARES[0]);
+
+// PROTOTYPES for functions used by this test program:
+bool test_shape( );
+// Postcondition: The width and depth have been checked for several
+// epsilons and deltas, and the constructor has been checked to throw
+// invalid_argument for values out of range. The return value is true if
+// all of these passed.
+
+bool test_bounds( );
+// Postcondition: A sketch has been filled from a skewed stream, and count
+// has been checked against the true counts: never smaller, and more than
+// epsilon * size( ) larger for at most a few items. The return value is
+// true if all of these passed.
+
+bool test_merge( );
+// Postcondition: operator + and += have been checked on two sketches of
+// the same shape (and of different shapes, which must throw), and on a
+// sketch added to itself. The return value is true if all passed.
+
+bool test_heavy( );
+// Postcondition: heavy_hitters and is_heavy have been checked on a skewed
+// stream, before and after a merge. The return value is true if all of
+// these passed.
+
+void fill(sketch& s, size_t n, mt19937& gen, vector<size_t>& truth);
+// Postcondition: n items of a skewed stream have been inserted into s (a
+// few of them several copies at a time), and each has been counted in
+// truth (which has VALUES entries).
+
+bool check(bool condition, const char message[ ]);
+// Postcondition: If condition is false, then message has been written to
+// cout. The return value is condition.
+
+
+int main( )
+{
+    bool passed = true;
+
+    passed &= test_shape( );
+    passed &= test_bounds( );
+    passed &= test_merge( );
+    passed &= test_heavy( );
+
+    cout << (passed ? "All tests passed." : "SOME TESTS FAILED.") << endl;
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+bool test_shape( )
+{
+    const double EPSILONS[ ] = { 0.5, 0.1, 0.01, 0.001 };
+    const double DELTAS[ ] = { 0.5, 0.1, 0.01, 1e-6, exp(-31.5) };
+    const double BAD_EPSILONS[ ] = { 0, 1, -0.5, NAN, 1e-30, 1e-300 };
+    const double BAD_DELTAS[ ] = { 0, 1, 2, NAN, 1e-20 };
+    bool passed = true;
+    double needed;
+    size_t e;
+    size_t d;
+
+    for (e = 0; e < sizeof(EPSILONS) / sizeof(EPSILONS[0]); ++e)
+        for (d = 0; d < sizeof(DELTAS) / sizeof(DELTAS[0]); ++d)
+        {
+            sketch s(EPSILONS[e], DELTAS[d]);
+            needed = ceil(exp(1.0) / EPSILONS[e]);
+            passed &= check(s.width( ) >= needed && s.width( ) < 2 * needed
+                            && (s.width( ) & (s.width( ) - 1)) == 0,
+                            "The width is not e / epsilon rounded up to a "
+                            "power of two.");
+            passed &= check(s.depth( ) == size_t(ceil(log(1 / DELTAS[d]))),
+                            "The depth is not ln(1 / delta) rounded up.");
+            passed &= check(s.size( ) == 0 && s.count(7) == 0,
+                            "A new sketch is not empty.");
+        }
+
+    for (e = 0; e < sizeof(BAD_EPSILONS) / sizeof(BAD_EPSILONS[0]); ++e)
+        try
+        {
+            sketch s(BAD_EPSILONS[e], 0.1);
+            passed &= check(false, "A bad epsilon was accepted.");
+        }
+        catch (const invalid_argument&) { }
+    for (d = 0; d < sizeof(BAD_DELTAS) / sizeof(BAD_DELTAS[0]); ++d)
+        try
+        {
+            sketch s(0.1, BAD_DELTAS[d]);
+            passed &= check(false, "A bad delta was accepted.");
+        }
+        catch (const invalid_argument&) { }
+
+    cout << "width and depth: " << (passed ? "passed" : "FAILED") << endl;
+    return passed;
+}
+
+bool test_bounds( )
+{
+    const double EPSILON = 0.001;
+    const double DELTA = 0.01;
+    sketch s(EPSILON, DELTA);
+    vector<size_t> truth(VALUES, 0);
+    mt19937 gen(2016);
+    size_t over = 0;    // Items overcounted by more than epsilon * size( )
+    bool passed = true;
+    int v;
+
+    fill(s, 200000, gen, truth);
+    for (v = 0; v < VALUES; ++v)
+    {
+        if (s.count(v) < truth[v])
+            passed &= check(false, "count is less than the true count.");
+        if (s.count(v) > truth[v] + EPSILON * s.size( ))
+            ++over;
+    }
+    passed &= check(s.size( ) == 200000 + 3 * 100,
+                    "size( ) is not the number of copies inserted.");
+    // Each item is overcounted that much with probability at most delta.
+    passed &= check(over <= 2 * DELTA * VALUES,
+                    "Too many counts are off by more than epsilon * size( ).");
+
+    s.clear( );
+    passed &= check(s.size( ) == 0 && s.count(0) == 0
+                    && s.heavy_hitters(0.01).empty( ),
+                    "clear did not empty the sketch.");
+
+    cout << "count bounds: " << (passed ? "passed" : "FAILED") << endl;
+    return passed;
+}
+
+bool test_merge( )
+{
+    sketch s1(0.01, 0.01);
+    sketch s2(0.01, 0.01);
+    vector<size_t> truth1(VALUES, 0);
+    vector<size_t> truth2(VALUES, 0);
+    mt19937 gen(3358);
+    bool passed = true;
+    bool exact = true;
+    int v;
+
+    fill(s1, 30000, gen, truth1);
+    fill(s2, 50000, gen, truth2);
+    sketch sum(s1 + s2);
+    passed &= check(sum.size( ) == s1.size( ) + s2.size( ),
+                    "The size of s1 + s2 is not the sum of the sizes.");
+    for (v = 0; v < VALUES; ++v)
+    {
+        if (sum.count(v) < truth1[v] + truth2[v])
+            passed &= check(false, "s1 + s2 undercounts an item.");
+        // The counters add, so the sum never undercounts either sketch.
+        if (sum.count(v) < s1.count(v) || sum.count(v) < s2.count(v))
+            passed &= check(false, "s1 + s2 counts less than s1 or s2.");
+    }
+
+    // s1 += s2 gives the same sketch as s1 + s2.
+    s1 += s2;
+    for (v = 0; v < VALUES; ++v)
+        exact &= (s1.count(v) == sum.count(v));
+    passed &= check(exact && s1.size( ) == sum.size( ),
+                    "s1 += s2 is not the same as s1 + s2.");
+
+    // Adding a sketch to itself doubles every counter.
+    sketch twice(s2);
+    twice += twice;
+    exact = true;
+    for (v = 0; v < VALUES; ++v)
+        exact &= (twice.count(v) == 2 * s2.count(v));
+    passed &= check(exact && twice.size( ) == 2 * s2.size( ),
+                    "s += s did not double the counts.");
+
+    // Sketches of other shapes are refused, and left unchanged.
+    sketch wide(0.001, 0.01);
+    sketch deep(0.01, 0.0001);
+    try
+    {
+        s2 += wide;
+        passed &= check(false, "+= of a wider sketch was accepted.");
+    }
+    catch (const invalid_argument&) { }
+    try
+    {
+        sketch bad(s2 + deep);
+        passed &= check(false, "+ of a deeper sketch was accepted.");
+    }
+    catch (const invalid_argument&) { }
+    passed &= check(s2.size( ) == 50000 + 3 * 100,
+                    "A refused += changed the sketch.");
+
+    cout << "merging: " << (passed ? "passed" : "FAILED") << endl;
+    return passed;
+}
+
+bool test_heavy( )
+{
+    sketch s1(0.001, 0.01);
+    sketch s2(0.001, 0.01);
+    vector<size_t> truth(VALUES, 0);
+    mt19937 gen(1);
+    vector<int> heavy;
+    bool passed = true;
+    int i;
+
+    fill(s1, 100000, gen, truth);
+    heavy = s1.heavy_hitters(0.05);
+    passed &= check(heavy.size( ) == size_t(MANY_SHARES),
+                    "heavy_hitters(0.05) did not find just the 3 frequent "
+                    "items.");
+    for (i = 0; i < MANY_SHARES && i < int(heavy.size( )); ++i)
+        passed &= check(heavy[i] == i, "heavy_hitters is not in order of "
+                        "frequency.");
+    passed &= check(s1.is_heavy(0, 0.25) && !s1.is_heavy(0, 0.4)
+                    && s1.is_heavy(2, 0.05) && !s1.is_heavy(VALUES - 1, 0.05),
+                    "is_heavy does not match the shares of the stream.");
+    heavy = s1.heavy_hitters(0.25);
+    passed &= check(heavy.size( ) == 1 && heavy[0] == 0,
+                    "heavy_hitters(0.25) did not find just item 0.");
+
+    // After a merge with another stream of the same shape, the frequent
+    // items are still found.
+    fill(s2, 100000, gen, truth);
+    s1 += s2;
+    heavy = s1.heavy_hitters(0.05);
+    passed &= check(heavy.size( ) == size_t(MANY_SHARES) && heavy[0] == 0,
+                    "heavy_hitters went wrong after +=.");
+
+    cout << "heavy hitters: " << (passed ? "passed" : "FAILED") << endl;
+    return passed;
+}
+
+void fill(sketch& s, size_t n, mt19937& gen, vector<size_t>& truth)
+{
+    uniform_real_distribution<double> share(0, 1);
+    double r;
+    double below;
+    size_t i;
+    int v;
+    int k;
+
+    for (i = 0; i < n; ++i)
+    {
+        // Item k with probability SHARES[k], else a uniform other value.
+        r = share(gen);
+        below = 0;
+        v = -1;
+        for (k = 0; k < MANY_SHARES && v < 0; ++k)
+        {
+            below += SHARES[k];
+            if (r < below)
+                v = k;
+        }
+        if (v < 0)
+            v = MANY_SHARES + int(gen( ) % (VALUES - MANY_SHARES));
+        s.insert(v);
+        ++truth[v];
+    }
+    // A few inserts of several copies at once.
+    for (i = 0; i < 100; ++i)
+    {
+        v = MANY_SHARES + int(i * 37 % (VALUES - MANY_SHARES));
+        s.insert(v, 3);
+        truth[v] += 3;
+    }
+}
+
+bool check(bool condition, const char message[ ])
+{
+    if (!condition)
+        cout << message << endl;
+    return condition;
+}
@@ -0,0 +1,226 @@
+// FILE: unrolled_node.h (part of the namespace main_savitch_6B)
+// PROVIDES: A template class for a node of an unrolled linked list, which
+// holds up to K items rather than one, and a forward iterator that steps
+// through the items of such a list. Following a link usually means a cache
+// miss, while the items within one node lie next to each other in memory, so
+// a scan of an unrolled list follows about 1/K as many links as a scan of an
+// ordinary list of node<Item>.
+//
+// TEMPLATE PARAMETERS and TYPEDEFS for the unrolled_node<Item, K> class:
+//   Item is the type of the items, with the same requirements as for
+//   node<Item> (see node2.h); it must also have a default constructor. K is
+//   the largest number of items in one node. By default K is chosen so that
+//   a node of small items fills about UNROLLED_NODE_BYTES bytes (two cache
+//   lines on most machines), and K is at least 1.
+//   unrolled_node<Item, K>::value_type is Item, size_type is std::size_t,
+//   and CAPACITY is K.
+//
+// CONSTRUCTOR for the unrolled_node<Item, K> class:
+//   unrolled_node(const Item& init_data = Item( ), unrolled_node* init_link = NULL)
+//     Postcondition: The node contains the one item init_data, and the
+//     specified link.
+//
+// MEMBER FUNCTIONS for the unrolled_node<Item, K> class:
+//   const Item& data(size_type i) const <----- const version
+//   and
+//   Item& data(size_type i) <------------------- non-const version
+//     Precondition: i < size( ).
+//     Postcondition: The return value is a reference to item number i of this
+//     node (the first is item 0).
+//
+//   const unrolled_node* link( ) const <----- const version
+//   and
+//   unrolled_node* link( ) <----------------- non-const version
+//     Postcondition: The return value is the link from this node.
+//
+//   size_type size( ) const
+//     Postcondition: The return value is the number of items in this node.
+//
+//   bool is_full( ) const
+//     Postcondition: The return value is true if size( ) == CAPACITY.
+//
+//   void set_data(size_type i, const Item& new_data)
+//     Precondition: i < size( ).
+//     Postcondition: Item number i of this node is now new_data.
+//
+//   void set_link(unrolled_node* new_link)
+//     Postcondition: The node now contains the specified new link.
+//
+//   void push(const Item& entry)
+//     Precondition: !is_full( ).
+//     Postcondition: entry has been added after the last item of the node.
+//
+//   void pop( )
+//     Precondition: size( ) > 0.
+//     Postcondition: The last item of the node has been removed.
+//
+// FUNCTION in the linked list toolkit for unrolled nodes:
+//   template <class Item, std::size_t K, class NodeAllocator>
+//   void list_copy(const unrolled_node<Item, K>* source_ptr,
+//                  unrolled_node<Item, K>*& head_ptr,
+//                  unrolled_node<Item, K>*& tail_ptr, NodeAllocator& alloc)
+//     Precondition: source_ptr is the head pointer of an unrolled linked list.
+//     alloc creates unrolled_node<Item, K> objects (see node_pool.h).
+//     Postcondition: head_ptr and tail_ptr are the head and tail pointers for
+//     a new list, made by alloc, with the same nodes holding the same items as
+//     the list pointed to by source_ptr. The original list is unaltered.
+//
+//   template <class Item, std::size_t K, class NodeAllocator>
+//   void list_copy(const unrolled_node<Item, K>* source_ptr, std::size_t many,
+//                  unrolled_node<Item, K>*& head_ptr,
+//                  unrolled_node<Item, K>*& tail_ptr, NodeAllocator& alloc)
+//     Precondition: source_ptr is the head pointer of an unrolled linked list
+//     of many nodes. alloc is as above.
+//     Postcondition: As for list_copy above, but alloc.reserve(many) is called
+//     first, so that a node_pool puts the whole copy in one contiguous block,
+//     in list order (see node_pool.h).
+//
+// ITERATORS for an unrolled linked list:
+//   node_iterator<Item, unrolled_node<Item, K> > and
+//   const_node_iterator<Item, unrolled_node<Item, K> > are forward iterators
+//   like those of node2.h, except that they step through every item of a
+//   node before following its link. They are constructed from a pointer to
+//   the first node to visit (or with no argument, for the position beyond
+//   the end). No node of a list stepped through may be empty.
+//
+// DYNAMIC MEMORY usage:
+//   If there is insufficient dynamic memory, then list_copy throws bad_alloc.
+
+#ifndef MAIN_SAVITCH_UNROLLED_NODE_H
+#define MAIN_SAVITCH_UNROLLED_NODE_H
+#include <cassert>   // Provides assert
+#include <cstddef>   // Provides ptrdiff_t
+#include <cstdlib>   // Provides NULL and size_t
+#include <iterator>  // Provides forward_iterator_tag
+#include "node2.h"   // Provides node_iterator and const_node_iterator
+
+namespace main_savitch_6B
+{
+    const std::size_t UNROLLED_NODE_BYTES = 128;
+
+    template <class Item,
+              std::size_t K = (sizeof(Item) * 2 < UNROLLED_NODE_BYTES)
+                  ? (UNROLLED_NODE_BYTES - 2 * sizeof(void*)) / sizeof(Item) : 1>
+    class unrolled_node
+    {
+    public:
+        // TYPEDEFS and MEMBER CONSTANTS
+	typedef Item value_type;
+	typedef std::size_t size_type;
+	static const size_type CAPACITY = K;
+        // CONSTRUCTOR
+	unrolled_node(const Item& init_data=Item( ), unrolled_node* init_link=NULL)
+	    { data_field[0] = init_data; used = 1; link_field = init_link; }
+        // MODIFICATION MEMBER FUNCTIONS
+	Item& data(size_type i) { assert(i < used); return data_field[i]; }
+	unrolled_node* link( ) { return link_field; }
+	void set_data(size_type i, const Item& new_data)
+	    { assert(i < used); data_field[i] = new_data; }
+	void set_link(unrolled_node* new_link) { link_field = new_link; }
+	void push(const Item& entry)
+	    { assert(used < K); data_field[used] = entry; ++used; }
+	void pop( ) { assert(used > 0); --used; }
+        // CONST MEMBER FUNCTIONS
+	const Item& data(size_type i) const
+	    { assert(i < used); return data_field[i]; }
+	const unrolled_node* link( ) const { return link_field; }
+	size_type size( ) const { return used; }
+	bool is_full( ) const { return used == K; }
+    private:
+	Item data_field[K];
+	size_type used;
+	unrolled_node *link_field;
+    };
+
+    // FUNCTIONS to copy an unrolled linked list:
+    template <class Item, std::size_t K, class NodeAllocator>
+    void list_copy
+        (const unrolled_node<Item, K>* source_ptr, unrolled_node<Item, K>*& head_ptr,
+	 unrolled_node<Item, K>*& tail_ptr, NodeAllocator& alloc);
+
+    template <class Item, std::size_t K, class NodeAllocator>
+    void list_copy
+        (const unrolled_node<Item, K>* source_ptr, std::size_t many,
+	 unrolled_node<Item, K>*& head_ptr, unrolled_node<Item, K>*& tail_ptr,
+	 NodeAllocator& alloc);
+
+    // FORWARD ITERATORS to step through the items of an unrolled linked list
+    template <class Item, std::size_t K>
+    class node_iterator<Item, unrolled_node<Item, K> >
+    {
+    public:
+	// TYPEDEFS for std::iterator_traits
+	typedef std::forward_iterator_tag iterator_category;
+	typedef Item value_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef Item* pointer;
+	typedef Item& reference;
+	node_iterator(unrolled_node<Item, K>* initial = NULL)
+	    { current = initial; index = 0; }
+	Item& operator *( ) const
+	    { return current->data(index); }
+	node_iterator& operator ++( ) // Prefix ++
+	    {
+		if (++index == current->size( ))
+		{
+		    current = current->link( );
+		    index = 0;
+		}
+		return *this;
+	    }
+	node_iterator operator ++(int) // Postfix ++
+	    {
+		node_iterator original(*this);
+		++*this;
+		return original;
+	    }
+	bool operator ==(const node_iterator other) const
+	    { return current == other.current && index == other.index; }
+	bool operator !=(const node_iterator other) const
+	    { return current != other.current || index != other.index; }
+    private:
+	unrolled_node<Item, K>* current;
+	std::size_t index;      // Position of the current item in *current
+    };
+
+    template <class Item, std::size_t K>
+    class const_node_iterator<Item, unrolled_node<Item, K> >
+    {
+    public:
+	// TYPEDEFS for std::iterator_traits
+	typedef std::forward_iterator_tag iterator_category;
+	typedef Item value_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef const Item* pointer;
+	typedef const Item& reference;
+	const_node_iterator(const unrolled_node<Item, K>* initial = NULL)
+	    { current = initial; index = 0; }
+	const Item& operator *( ) const
+	    { return current->data(index); }
+	const_node_iterator& operator ++( ) // Prefix ++
+	    {
+		if (++index == current->size( ))
+		{
+		    current = current->link( );
+		    index = 0;
+		}
+		return *this;
+	    }
+	const_node_iterator operator ++(int) // Postfix ++
+	    {
+		const_node_iterator original(*this);
+		++*this;
+		return original;
+	    }
+	bool operator ==(const const_node_iterator other) const
+	    { return current == other.current && index == other.index; }
+	bool operator !=(const const_node_iterator other) const
+	    { return current != other.current || index != other.index; }
+    private:
+	const unrolled_node<Item, K>* current;
+	std::size_t index;      // Position of the current item in *current
+    };
+}
+
+#include "unrolled_node.template"
+#endif